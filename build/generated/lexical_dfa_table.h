@@ -0,0 +1,146 @@
+// Generated by tools/dfa_gen.c from DFA/lexical_DFA.dot. Do not edit.
+
+#ifndef LEXICAL_DFA_TABLE_H
+#define LEXICAL_DFA_TABLE_H
+
+#include <stddef.h> // NULL
+
+// Row of each state of the dot file
+#define LA_DFA_STATE_0 0
+#define LA_DFA_STATE_1 1
+#define LA_DFA_STATE_2 2
+#define LA_DFA_STATE_3 3
+#define LA_DFA_STATE_4 4
+#define LA_DFA_STATE_5 5
+#define LA_DFA_STATE_6 6
+#define LA_DFA_STATE_7 7
+#define LA_DFA_STATE_8 8
+#define LA_DFA_STATE_9 9
+#define LA_DFA_STATE_10 10
+#define LA_DFA_STATE_11 11
+#define LA_DFA_STATE_12 12
+#define LA_DFA_STATE_13 13
+#define LA_DFA_STATE_51 14
+#define LA_DFA_STATE_52 15
+#define LA_DFA_STATE_53 16
+#define LA_DFA_STATE_54 17
+#define LA_DFA_STATE_55 18
+
+#define LA_DFA_STATE_COUNT 19
+#define LA_DFA_CLASS_COUNT 17 // including EOF
+#define LA_DFA_EOF_CLASS 16
+#define LA_DFA_LOOKAHEAD 0x80 // transition does not consume the char
+#define LA_DFA_STATE_MASK 0x7F
+#define LA_DFA_END 0x7E // end of input, no more tokens
+#define LA_DFA_ERROR 0x7F // no transition, see la_dfa_onError
+
+typedef enum LaDfaAction
+{
+    LaDfaAction_NONE,
+    LaDfaAction_INVALID_CHAR,
+    LaDfaAction_EXPECTED_CHAR,
+    LaDfaAction_EXPECTED_SEQUENCE,
+    LaDfaAction_MISSING_SEQUENCE
+} LaDfaAction;
+
+typedef struct LaDfaErrorAction
+{
+    LaDfaAction action;
+    const char* arg;
+} LaDfaErrorAction;
+
+static const unsigned char la_dfa_charClass[256] =
+{
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  2,  0,  0,  1,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  3,  4,  0,  0,  0,  5,  0,  6,  6,  7,  6,  6,  6,  8,  9,
+    10, 11, 11, 11, 11, 11, 11, 11, 11, 11,  0,  6,  3, 12,  3,  0,
+     0, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,  0,  0,  0,  0, 14,
+     0, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+    13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,  6, 15,  6,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static const unsigned char la_dfa_next[LA_DFA_STATE_COUNT][LA_DFA_CLASS_COUNT] =
+{
+    {0x7F, 0x00, 0x00, 0x01, 0x06, 0x03, 0x12, 0x12, 0x7F, 0x05, 0x08, 0x07, 0x01, 0x04, 0x7F, 0x02, 0x7E}, // 0
+    {0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x12, 0x92, 0x92, 0x92, 0x92}, // 1
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x12, 0x7F}, // 2
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x12, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 3
+    {0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x04, 0x04, 0x90, 0x04, 0x04, 0x90, 0x90}, // 4
+    {0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x0C, 0x92, 0x0B, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92}, // 5
+    {0x06, 0x06, 0x7F, 0x06, 0x11, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x7F}, // 6
+    {0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x09, 0x8E, 0x07, 0x07, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E}, // 7
+    {0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x09, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E, 0x8E}, // 8
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x0A, 0x0A, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 9
+    {0x8F, 0x8F, 0x8F, 0x8F, 0x8F, 0x8F, 0x8F, 0x8F, 0x8F, 0x8F, 0x0A, 0x0A, 0x8F, 0x8F, 0x8F, 0x8F, 0x8F}, // 10
+    {0x0B, 0x0B, 0x00, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x7E}, // 11
+    {0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0D, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x7F}, // 12
+    {0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0D, 0x0C, 0x00, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x7F}, // 13
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 51
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 52
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 53
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 54
+    {0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F, 0x7F}, // 55
+};
+
+static const unsigned char la_dfa_isFinal[LA_DFA_STATE_COUNT] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1,
+};
+
+static const LaDfaErrorAction la_dfa_onError[LA_DFA_STATE_COUNT] =
+{
+    {LaDfaAction_INVALID_CHAR, NULL}, // 0
+    {LaDfaAction_NONE, NULL}, // 1
+    {LaDfaAction_EXPECTED_CHAR, "|"}, // 2
+    {LaDfaAction_EXPECTED_CHAR, "&"}, // 3
+    {LaDfaAction_NONE, NULL}, // 4
+    {LaDfaAction_NONE, NULL}, // 5
+    {LaDfaAction_MISSING_SEQUENCE, "\""}, // 6
+    {LaDfaAction_NONE, NULL}, // 7
+    {LaDfaAction_NONE, NULL}, // 8
+    {LaDfaAction_EXPECTED_SEQUENCE, "digit"}, // 9
+    {LaDfaAction_NONE, NULL}, // 10
+    {LaDfaAction_NONE, NULL}, // 11
+    {LaDfaAction_NONE, NULL}, // 12
+    {LaDfaAction_NONE, NULL}, // 13
+    {LaDfaAction_NONE, NULL}, // 51
+    {LaDfaAction_NONE, NULL}, // 52
+    {LaDfaAction_NONE, NULL}, // 53
+    {LaDfaAction_NONE, NULL}, // 54
+    {LaDfaAction_NONE, NULL}, // 55
+};
+
+static const LaDfaErrorAction la_dfa_onEof[LA_DFA_STATE_COUNT] =
+{
+    {LaDfaAction_NONE, NULL}, // 0
+    {LaDfaAction_NONE, NULL}, // 1
+    {LaDfaAction_MISSING_SEQUENCE, "|"}, // 2
+    {LaDfaAction_MISSING_SEQUENCE, "&"}, // 3
+    {LaDfaAction_NONE, NULL}, // 4
+    {LaDfaAction_NONE, NULL}, // 5
+    {LaDfaAction_MISSING_SEQUENCE, "\""}, // 6
+    {LaDfaAction_NONE, NULL}, // 7
+    {LaDfaAction_NONE, NULL}, // 8
+    {LaDfaAction_MISSING_SEQUENCE, "digit"}, // 9
+    {LaDfaAction_NONE, NULL}, // 10
+    {LaDfaAction_NONE, NULL}, // 11
+    {LaDfaAction_MISSING_SEQUENCE, "*/"}, // 12
+    {LaDfaAction_MISSING_SEQUENCE, "/"}, // 13
+    {LaDfaAction_NONE, NULL}, // 51
+    {LaDfaAction_NONE, NULL}, // 52
+    {LaDfaAction_NONE, NULL}, // 53
+    {LaDfaAction_NONE, NULL}, // 54
+    {LaDfaAction_NONE, NULL}, // 55
+};
+
+#endif // LEXICAL_DFA_TABLE_H
@@ -0,0 +1,812 @@
+// Generated by tools/ll1_gen.c from grammar/syntactic.ll1. Do not edit.
+
+#ifndef SYNTACTIC_LL1_TABLE_H
+#define SYNTACTIC_LL1_TABLE_H
+
+#include "lexical/token.h"
+
+#include <stdint.h>
+
+typedef enum SaRule
+{
+    SaRule_PROGRAM,
+    SaRule_DECLS,
+    SaRule_DECL_UNIT,
+    SaRule_DECL,
+    SaRule_IDENT_LIST,
+    SaRule_IDENT_LIST_I,
+    SaRule_TYPE,
+    SaRule_BODY,
+    SaRule_BLOCK,
+    SaRule_STMT_LIST,
+    SaRule_STMT_LIST_I,
+    SaRule_STMT_UNIT,
+    SaRule_STMT,
+    SaRule_ASSIGN_STMT,
+    SaRule_IF_STMT,
+    SaRule_IF_STMT_I,
+    SaRule_DO_STMT,
+    SaRule_DO_SUFFIX,
+    SaRule_READ_STMT,
+    SaRule_WRITE_STMT,
+
+    // Not to be used, only to get how many rules are
+    SaRule_SIZE
+} SaRule;
+
+typedef enum SaAction
+{
+    SaAction_PROGRAM,
+    SaAction_PROGRAM_NAME,
+    SaAction_DECLARATIONS,
+    SaAction_STATEMENTS,
+    SaAction_CHILD,
+    SaAction_DECL_UNIT,
+    SaAction_DECL_END,
+    SaAction_DECL_TYPE,
+    SaAction_DECLARE,
+    SaAction_BLOCK,
+    SaAction_END,
+    SaAction_SCOPE_BLOCK,
+    SaAction_SCOPE_END,
+    SaAction_STMT_UNIT,
+    SaAction_STMT_END,
+    SaAction_ASSIGN,
+    SaAction_ASSIGN_VALUE,
+    SaAction_IF,
+    SaAction_CONDITION,
+    SaAction_DO,
+    SaAction_READ,
+    SaAction_READ_VAR,
+    SaAction_WRITE,
+    SaAction_WRITABLE,
+
+    // Not to be used, only to get how many actions are
+    SaAction_SIZE
+} SaAction;
+
+// Symbols of the alternatives: TokenTypes, then rules and actions
+#define SA_LL1_RULE 0x100 // | SaRule
+#define SA_LL1_ACTION 0x200 // | SaAction
+
+// Each alternative backwards, as it is pushed on the parser stack
+static const uint16_t sa_ll1_symbols[] =
+{
+    // program : @program CLASS @program-name ID @declarations decls @statements @block OPEN_CUR @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @end @child END_OF_FILE
+    TokenType_END_OF_FILE,
+    SA_LL1_ACTION | SaAction_CHILD,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_BLOCK,
+    SA_LL1_ACTION | SaAction_STATEMENTS,
+    SA_LL1_RULE | SaRule_DECLS,
+    SA_LL1_ACTION | SaAction_DECLARATIONS,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_PROGRAM_NAME,
+    TokenType_CLASS,
+    SA_LL1_ACTION | SaAction_PROGRAM,
+    // decls : @decl-unit @decl-type type @declare ID ident-list-i SEMICOLON @decl-end decls
+    SA_LL1_RULE | SaRule_DECLS,
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    SA_LL1_RULE | SaRule_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decls : lambda
+    // decl-unit : @decl-unit @decl-type type @declare ID ident-list-i SEMICOLON @decl-end
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    SA_LL1_RULE | SaRule_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decl : @decl-type type @declare ID ident-list-i
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    SA_LL1_RULE | SaRule_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    // ident-list : @declare ID ident-list-i
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    // ident-list-i : COLON @declare ID ident-list-i
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_COLON,
+    // ident-list-i : lambda
+    // type : INT
+    TokenType_INT,
+    // type : STRING
+    TokenType_STRING,
+    // type : FLOAT
+    TokenType_FLOAT,
+    // body : @block OPEN_CUR @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @end
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_BLOCK,
+    // block : @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    // stmt-list : @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i : @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i : lambda
+    // stmt-unit : @stmt-unit stmt SEMICOLON @stmt-end
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt : @assign ID ASSIGN @assign-value
+    SA_LL1_ACTION | SaAction_ASSIGN_VALUE,
+    TokenType_ASSIGN,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_ASSIGN,
+    // stmt : @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end
+    SA_LL1_ACTION | SaAction_END,
+    SA_LL1_RULE | SaRule_IF_STMT_I,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_IF,
+    SA_LL1_ACTION | SaAction_IF,
+    // stmt : @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_WHILE,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_DO,
+    SA_LL1_ACTION | SaAction_DO,
+    // stmt : @read READ OPEN_PAR @read-var ID CLOSE_PAR
+    TokenType_CLOSE_PAR,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_READ_VAR,
+    TokenType_OPEN_PAR,
+    TokenType_READ,
+    SA_LL1_ACTION | SaAction_READ,
+    // stmt : @write WRITE OPEN_PAR @writable CLOSE_PAR @end
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_WRITABLE,
+    TokenType_OPEN_PAR,
+    TokenType_WRITE,
+    SA_LL1_ACTION | SaAction_WRITE,
+    // assign-stmt : @assign ID ASSIGN @assign-value
+    SA_LL1_ACTION | SaAction_ASSIGN_VALUE,
+    TokenType_ASSIGN,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_ASSIGN,
+    // if-stmt : @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end
+    SA_LL1_ACTION | SaAction_END,
+    SA_LL1_RULE | SaRule_IF_STMT_I,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_IF,
+    SA_LL1_ACTION | SaAction_IF,
+    // if-stmt-i : ELSE @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_ELSE,
+    // if-stmt-i : lambda
+    // do-stmt : @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_WHILE,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_DO,
+    SA_LL1_ACTION | SaAction_DO,
+    // do-suffix : WHILE OPEN_PAR @condition CLOSE_PAR
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_WHILE,
+    // read-stmt : @read READ OPEN_PAR @read-var ID CLOSE_PAR
+    TokenType_CLOSE_PAR,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_READ_VAR,
+    TokenType_OPEN_PAR,
+    TokenType_READ,
+    SA_LL1_ACTION | SaAction_READ,
+    // write-stmt : @write WRITE OPEN_PAR @writable CLOSE_PAR @end
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_WRITABLE,
+    TokenType_OPEN_PAR,
+    TokenType_WRITE,
+    SA_LL1_ACTION | SaAction_WRITE,
+    // decls => @decl-unit @decl-type INT @declare ID ident-list-i SEMICOLON @decl-end decls
+    SA_LL1_RULE | SaRule_DECLS,
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_INT,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decls => @decl-unit @decl-type STRING @declare ID ident-list-i SEMICOLON @decl-end decls
+    SA_LL1_RULE | SaRule_DECLS,
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_STRING,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decls => @decl-unit @decl-type FLOAT @declare ID ident-list-i SEMICOLON @decl-end decls
+    SA_LL1_RULE | SaRule_DECLS,
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_FLOAT,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decl-unit => @decl-unit @decl-type INT @declare ID ident-list-i SEMICOLON @decl-end
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_INT,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decl-unit => @decl-unit @decl-type STRING @declare ID ident-list-i SEMICOLON @decl-end
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_STRING,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decl-unit => @decl-unit @decl-type FLOAT @declare ID ident-list-i SEMICOLON @decl-end
+    SA_LL1_ACTION | SaAction_DECL_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_FLOAT,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    SA_LL1_ACTION | SaAction_DECL_UNIT,
+    // decl => @decl-type INT @declare ID ident-list-i
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_INT,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    // decl => @decl-type STRING @declare ID ident-list-i
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_STRING,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    // decl => @decl-type FLOAT @declare ID ident-list-i
+    SA_LL1_RULE | SaRule_IDENT_LIST_I,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_DECLARE,
+    TokenType_FLOAT,
+    SA_LL1_ACTION | SaAction_DECL_TYPE,
+    // stmt-list => @stmt-unit @assign ID ASSIGN @assign-value SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_ASSIGN_VALUE,
+    TokenType_ASSIGN,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_ASSIGN,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list => @stmt-unit @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    SA_LL1_RULE | SaRule_IF_STMT_I,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_IF,
+    SA_LL1_ACTION | SaAction_IF,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list => @stmt-unit @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_WHILE,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_DO,
+    SA_LL1_ACTION | SaAction_DO,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list => @stmt-unit @read READ OPEN_PAR @read-var ID CLOSE_PAR SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    TokenType_CLOSE_PAR,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_READ_VAR,
+    TokenType_OPEN_PAR,
+    TokenType_READ,
+    SA_LL1_ACTION | SaAction_READ,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list => @stmt-unit @write WRITE OPEN_PAR @writable CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_WRITABLE,
+    TokenType_OPEN_PAR,
+    TokenType_WRITE,
+    SA_LL1_ACTION | SaAction_WRITE,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-unit => @stmt-unit @assign ID ASSIGN @assign-value SEMICOLON @stmt-end
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_ASSIGN_VALUE,
+    TokenType_ASSIGN,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_ASSIGN,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-unit => @stmt-unit @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end SEMICOLON @stmt-end
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    SA_LL1_RULE | SaRule_IF_STMT_I,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_IF,
+    SA_LL1_ACTION | SaAction_IF,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-unit => @stmt-unit @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end SEMICOLON @stmt-end
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_WHILE,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_DO,
+    SA_LL1_ACTION | SaAction_DO,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-unit => @stmt-unit @read READ OPEN_PAR @read-var ID CLOSE_PAR SEMICOLON @stmt-end
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    TokenType_CLOSE_PAR,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_READ_VAR,
+    TokenType_OPEN_PAR,
+    TokenType_READ,
+    SA_LL1_ACTION | SaAction_READ,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-unit => @stmt-unit @write WRITE OPEN_PAR @writable CLOSE_PAR @end SEMICOLON @stmt-end
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_WRITABLE,
+    TokenType_OPEN_PAR,
+    TokenType_WRITE,
+    SA_LL1_ACTION | SaAction_WRITE,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i => @stmt-unit @assign ID ASSIGN @assign-value SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_ASSIGN_VALUE,
+    TokenType_ASSIGN,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_ASSIGN,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i => @stmt-unit @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    SA_LL1_RULE | SaRule_IF_STMT_I,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_IF,
+    SA_LL1_ACTION | SaAction_IF,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i => @stmt-unit @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_CONDITION,
+    TokenType_OPEN_PAR,
+    TokenType_WHILE,
+    SA_LL1_ACTION | SaAction_SCOPE_END,
+    TokenType_CLOSE_CUR,
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_RULE | SaRule_STMT,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    SA_LL1_RULE | SaRule_DECLS,
+    TokenType_OPEN_CUR,
+    SA_LL1_ACTION | SaAction_SCOPE_BLOCK,
+    TokenType_DO,
+    SA_LL1_ACTION | SaAction_DO,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i => @stmt-unit @read READ OPEN_PAR @read-var ID CLOSE_PAR SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    TokenType_CLOSE_PAR,
+    TokenType_ID,
+    SA_LL1_ACTION | SaAction_READ_VAR,
+    TokenType_OPEN_PAR,
+    TokenType_READ,
+    SA_LL1_ACTION | SaAction_READ,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+    // stmt-list-i => @stmt-unit @write WRITE OPEN_PAR @writable CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    SA_LL1_RULE | SaRule_STMT_LIST_I,
+    SA_LL1_ACTION | SaAction_STMT_END,
+    TokenType_SEMICOLON,
+    SA_LL1_ACTION | SaAction_END,
+    TokenType_CLOSE_PAR,
+    SA_LL1_ACTION | SaAction_WRITABLE,
+    TokenType_OPEN_PAR,
+    TokenType_WRITE,
+    SA_LL1_ACTION | SaAction_WRITE,
+    SA_LL1_ACTION | SaAction_STMT_UNIT,
+};
+
+typedef struct SaLl1Production
+{
+    uint16_t first; // in sa_ll1_symbols
+    uint16_t length;
+} SaLl1Production;
+
+// Alternatives, numbered from 1 in grammar order, then the flattened ones (=>)
+#define SA_LL1_NONE 0 // no alternative: syntax error
+static const SaLl1Production sa_ll1_productions[] =
+{
+    [SA_LL1_NONE] = {0, 0},
+    {0, 18}, // 1: program : @program CLASS @program-name ID @declarations decls @statements @block OPEN_CUR @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @end @child END_OF_FILE
+    {18, 9}, // 2: decls : @decl-unit @decl-type type @declare ID ident-list-i SEMICOLON @decl-end decls
+    {27, 0}, // 3: decls : lambda
+    {27, 8}, // 4: decl-unit : @decl-unit @decl-type type @declare ID ident-list-i SEMICOLON @decl-end
+    {35, 5}, // 5: decl : @decl-type type @declare ID ident-list-i
+    {40, 3}, // 6: ident-list : @declare ID ident-list-i
+    {43, 4}, // 7: ident-list-i : COLON @declare ID ident-list-i
+    {47, 0}, // 8: ident-list-i : lambda
+    {47, 1}, // 9: type : INT
+    {48, 1}, // 10: type : STRING
+    {49, 1}, // 11: type : FLOAT
+    {50, 9}, // 12: body : @block OPEN_CUR @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @end
+    {59, 10}, // 13: block : @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end
+    {69, 5}, // 14: stmt-list : @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i
+    {74, 5}, // 15: stmt-list-i : @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i
+    {79, 0}, // 16: stmt-list-i : lambda
+    {79, 4}, // 17: stmt-unit : @stmt-unit stmt SEMICOLON @stmt-end
+    {83, 4}, // 18: stmt : @assign ID ASSIGN @assign-value
+    {87, 17}, // 19: stmt : @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end
+    {104, 17}, // 20: stmt : @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end
+    {121, 6}, // 21: stmt : @read READ OPEN_PAR @read-var ID CLOSE_PAR
+    {127, 6}, // 22: stmt : @write WRITE OPEN_PAR @writable CLOSE_PAR @end
+    {133, 4}, // 23: assign-stmt : @assign ID ASSIGN @assign-value
+    {137, 17}, // 24: if-stmt : @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end
+    {154, 11}, // 25: if-stmt-i : ELSE @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end
+    {165, 0}, // 26: if-stmt-i : lambda
+    {165, 17}, // 27: do-stmt : @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end
+    {182, 4}, // 28: do-suffix : WHILE OPEN_PAR @condition CLOSE_PAR
+    {186, 6}, // 29: read-stmt : @read READ OPEN_PAR @read-var ID CLOSE_PAR
+    {192, 6}, // 30: write-stmt : @write WRITE OPEN_PAR @writable CLOSE_PAR @end
+    {198, 9}, // 31: decls => @decl-unit @decl-type INT @declare ID ident-list-i SEMICOLON @decl-end decls
+    {207, 9}, // 32: decls => @decl-unit @decl-type STRING @declare ID ident-list-i SEMICOLON @decl-end decls
+    {216, 9}, // 33: decls => @decl-unit @decl-type FLOAT @declare ID ident-list-i SEMICOLON @decl-end decls
+    {225, 8}, // 34: decl-unit => @decl-unit @decl-type INT @declare ID ident-list-i SEMICOLON @decl-end
+    {233, 8}, // 35: decl-unit => @decl-unit @decl-type STRING @declare ID ident-list-i SEMICOLON @decl-end
+    {241, 8}, // 36: decl-unit => @decl-unit @decl-type FLOAT @declare ID ident-list-i SEMICOLON @decl-end
+    {249, 5}, // 37: decl => @decl-type INT @declare ID ident-list-i
+    {254, 5}, // 38: decl => @decl-type STRING @declare ID ident-list-i
+    {259, 5}, // 39: decl => @decl-type FLOAT @declare ID ident-list-i
+    {264, 8}, // 40: stmt-list => @stmt-unit @assign ID ASSIGN @assign-value SEMICOLON @stmt-end stmt-list-i
+    {272, 21}, // 41: stmt-list => @stmt-unit @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end SEMICOLON @stmt-end stmt-list-i
+    {293, 21}, // 42: stmt-list => @stmt-unit @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    {314, 10}, // 43: stmt-list => @stmt-unit @read READ OPEN_PAR @read-var ID CLOSE_PAR SEMICOLON @stmt-end stmt-list-i
+    {324, 10}, // 44: stmt-list => @stmt-unit @write WRITE OPEN_PAR @writable CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    {334, 7}, // 45: stmt-unit => @stmt-unit @assign ID ASSIGN @assign-value SEMICOLON @stmt-end
+    {341, 20}, // 46: stmt-unit => @stmt-unit @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end SEMICOLON @stmt-end
+    {361, 20}, // 47: stmt-unit => @stmt-unit @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end SEMICOLON @stmt-end
+    {381, 9}, // 48: stmt-unit => @stmt-unit @read READ OPEN_PAR @read-var ID CLOSE_PAR SEMICOLON @stmt-end
+    {390, 9}, // 49: stmt-unit => @stmt-unit @write WRITE OPEN_PAR @writable CLOSE_PAR @end SEMICOLON @stmt-end
+    {399, 8}, // 50: stmt-list-i => @stmt-unit @assign ID ASSIGN @assign-value SEMICOLON @stmt-end stmt-list-i
+    {407, 21}, // 51: stmt-list-i => @stmt-unit @if IF OPEN_PAR @condition CLOSE_PAR @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end if-stmt-i @end SEMICOLON @stmt-end stmt-list-i
+    {428, 21}, // 52: stmt-list-i => @stmt-unit @do DO @scope-block OPEN_CUR decls @stmt-unit stmt SEMICOLON @stmt-end stmt-list-i CLOSE_CUR @scope-end WHILE OPEN_PAR @condition CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+    {449, 10}, // 53: stmt-list-i => @stmt-unit @read READ OPEN_PAR @read-var ID CLOSE_PAR SEMICOLON @stmt-end stmt-list-i
+    {459, 10}, // 54: stmt-list-i => @stmt-unit @write WRITE OPEN_PAR @writable CLOSE_PAR @end SEMICOLON @stmt-end stmt-list-i
+};
+
+// Alternative of each rule to expand on each lookahead token, flattened up to its first
+// terminal. Lambda alternatives are predicted on the Follow of their rule
+static const unsigned char sa_ll1_predict[SaRule_SIZE][TokenType_SIZE] =
+{
+    [SaRule_PROGRAM] =
+    {
+        [TokenType_CLASS] = 1,
+    },
+    [SaRule_DECLS] =
+    {
+        [TokenType_ID] = 3,
+        [TokenType_INT] = 31,
+        [TokenType_STRING] = 32,
+        [TokenType_FLOAT] = 33,
+        [TokenType_OPEN_CUR] = 3,
+        [TokenType_IF] = 3,
+        [TokenType_DO] = 3,
+        [TokenType_READ] = 3,
+        [TokenType_WRITE] = 3,
+    },
+    [SaRule_DECL_UNIT] =
+    {
+        [TokenType_INT] = 34,
+        [TokenType_STRING] = 35,
+        [TokenType_FLOAT] = 36,
+    },
+    [SaRule_DECL] =
+    {
+        [TokenType_INT] = 37,
+        [TokenType_STRING] = 38,
+        [TokenType_FLOAT] = 39,
+    },
+    [SaRule_IDENT_LIST] =
+    {
+        [TokenType_ID] = 6,
+    },
+    [SaRule_IDENT_LIST_I] =
+    {
+        [TokenType_SEMICOLON] = 8,
+        [TokenType_COLON] = 7,
+    },
+    [SaRule_TYPE] =
+    {
+        [TokenType_INT] = 9,
+        [TokenType_STRING] = 10,
+        [TokenType_FLOAT] = 11,
+    },
+    [SaRule_BODY] =
+    {
+        [TokenType_OPEN_CUR] = 12,
+    },
+    [SaRule_BLOCK] =
+    {
+        [TokenType_OPEN_CUR] = 13,
+    },
+    [SaRule_STMT_LIST] =
+    {
+        [TokenType_ID] = 40,
+        [TokenType_IF] = 41,
+        [TokenType_DO] = 42,
+        [TokenType_READ] = 43,
+        [TokenType_WRITE] = 44,
+    },
+    [SaRule_STMT_LIST_I] =
+    {
+        [TokenType_ID] = 50,
+        [TokenType_CLOSE_CUR] = 16,
+        [TokenType_IF] = 51,
+        [TokenType_DO] = 52,
+        [TokenType_READ] = 53,
+        [TokenType_WRITE] = 54,
+    },
+    [SaRule_STMT_UNIT] =
+    {
+        [TokenType_ID] = 45,
+        [TokenType_IF] = 46,
+        [TokenType_DO] = 47,
+        [TokenType_READ] = 48,
+        [TokenType_WRITE] = 49,
+    },
+    [SaRule_STMT] =
+    {
+        [TokenType_ID] = 18,
+        [TokenType_IF] = 19,
+        [TokenType_DO] = 20,
+        [TokenType_READ] = 21,
+        [TokenType_WRITE] = 22,
+    },
+    [SaRule_ASSIGN_STMT] =
+    {
+        [TokenType_ID] = 23,
+    },
+    [SaRule_IF_STMT] =
+    {
+        [TokenType_IF] = 24,
+    },
+    [SaRule_IF_STMT_I] =
+    {
+        [TokenType_SEMICOLON] = 26,
+        [TokenType_ELSE] = 25,
+    },
+    [SaRule_DO_STMT] =
+    {
+        [TokenType_DO] = 27,
+    },
+    [SaRule_DO_SUFFIX] =
+    {
+        [TokenType_WHILE] = 28,
+    },
+    [SaRule_READ_STMT] =
+    {
+        [TokenType_READ] = 29,
+    },
+    [SaRule_WRITE_STMT] =
+    {
+        [TokenType_WRITE] = 30,
+    },
+};
+
+// Alternative to expand on the tokens that predict none: the lambda one, or the only
+// one, so the error shows at the next terminal. SA_LL1_NONE if there are several
+static const unsigned char sa_ll1_default[SaRule_SIZE] =
+{
+    [SaRule_PROGRAM] = 1,
+    [SaRule_DECLS] = 3,
+    [SaRule_DECL_UNIT] = 4,
+    [SaRule_DECL] = 5,
+    [SaRule_IDENT_LIST] = 6,
+    [SaRule_IDENT_LIST_I] = 8,
+    [SaRule_TYPE] = 0,
+    [SaRule_BODY] = 12,
+    [SaRule_BLOCK] = 13,
+    [SaRule_STMT_LIST] = 14,
+    [SaRule_STMT_LIST_I] = 16,
+    [SaRule_STMT_UNIT] = 17,
+    [SaRule_STMT] = 0,
+    [SaRule_ASSIGN_STMT] = 23,
+    [SaRule_IF_STMT] = 24,
+    [SaRule_IF_STMT_I] = 26,
+    [SaRule_DO_STMT] = 27,
+    [SaRule_DO_SUFFIX] = 28,
+    [SaRule_READ_STMT] = 29,
+    [SaRule_WRITE_STMT] = 30,
+};
+
+#endif // SYNTACTIC_LL1_TABLE_H
@@ -0,0 +1,94 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Abstract syntax tree built by the syntactic analyzer. Nodes are fixed
+* size and live in one array, addressed by 32 bit indices instead of
+* pointers: children are reached through the first child and the next
+* sibling of each node. Nodes are appended in parse order, so a node
+* usually sits right before its first child
+*/
+
+#ifndef AST_H
+#define AST_H
+
+#include <stdint.h>
+
+#define AST_NONE UINT32_MAX
+
+typedef uint32_t AstIndex;
+
+typedef enum AstKind
+{
+    AstKind_PROGRAM, // var.symbolId: class name. Children: DECL..., BLOCK
+    AstKind_BLOCK, // children: DECL..., statements
+    AstKind_DECL, // var: declared name, decl is the node itself
+    AstKind_ASSIGN, // var: target. Child: expression
+    AstKind_IF, // children: condition, BLOCK, [else BLOCK]
+    AstKind_DO, // children: BLOCK, condition
+    AstKind_READ, // var: target, decl is AST_NONE if it was never declared
+    AstKind_WRITE, // child: expression
+
+    // Expressions, typed by dtype
+    AstKind_BINARY, // op. Children: left, right
+    AstKind_UNARY, // op. Child: operand
+    AstKind_ID, // var
+    AstKind_CONSTANT, // intVal (1 or 0 for booleans), realVal or literalId, as of dtype
+
+    // Not to be used, only to get how many kinds are
+    AstKind_SIZE
+} AstKind;
+
+typedef struct AstNode
+{
+    uint8_t kind; // AstKind
+    uint8_t dtype; // DataType of expressions and variables
+    uint8_t op; // TokenType of BINARY and UNARY
+    uint32_t offset; // input offset of the token the node comes from
+    AstIndex child; // first
+    AstIndex sibling; // next
+    union
+    {
+        struct
+        {
+            uint32_t symbolId; // Interner id of the name
+            AstIndex decl; // DECL node of the variable, which tells shadowed names apart
+        } var;
+        long intVal;
+        double realVal;
+        uint32_t literalId; // Interner id, without the quotes
+    };
+} AstNode;
+
+typedef struct Ast
+{
+    AstNode* nodes; // the root PROGRAM is nodes[0]
+    uint32_t size;
+    uint32_t capacity;
+} Ast;
+
+// Forward declarations
+struct Interner;
+
+void ast_init(Ast* self);
+void ast_free(Ast* self);
+// Makes room for capacity nodes, so building that many does not reallocate
+void ast_reserve(Ast* self, uint32_t capacity);
+
+// New childless node. Indices stay valid, but pointers to nodes do not survive it
+AstIndex ast_newNode(Ast* self, AstKind kind, uint32_t offset);
+// Links child after prev, the last child of parent so far (AST_NONE if it has none). Returns child
+AstIndex ast_addChild(Ast* self, AstIndex parent, AstIndex prev, AstIndex child);
+
+const char* ast_kind_toString(AstKind kind);
+// One node per line, children indented under their parent
+void ast_print(const Ast* self, const struct Interner* interner);
+
+#endif // AST_H
@@ -0,0 +1,64 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Linear scan register allocation. Each virtual register of an Ir gets a
+* single live interval over the instructions in layout order, covering the
+* blocks it is live across (holes included), and is given one physical
+* register for all of it, or a stack slot. Intervals are visited by start:
+* when registers run out, the one ending last is spilled.
+*
+* Floats and the other types are allocated from two separate classes of
+* registers. The target tells how many registers each class has, and which
+* instructions are calls: an interval living across one only gets a
+* register preserved by calls, or is spilled
+*/
+
+#ifndef LINEAR_SCAN_H
+#define LINEAR_SCAN_H
+
+#include <stdint.h>
+
+#define LINEAR_SCAN_MAX_REGS 32
+
+typedef enum RegClass
+{
+    RegClass_GENERAL, // ints, booleans and strings
+    RegClass_FLOAT,
+
+    // Not to be used, only to get how many classes are
+    RegClass_SIZE
+} RegClass;
+
+typedef struct RegClassInfo
+{
+    uint32_t regCount; // at most LINEAR_SCAN_MAX_REGS
+    uint32_t calleeSaved; // registers [0, calleeSaved) are preserved by calls
+} RegClassInfo;
+
+typedef struct LinearScan
+{
+    // Of each virtual register: >= 0 is a physical register of its class, < 0 is the
+    // stack slot -1 - location. Meaningless for the ones never used
+    int32_t* locations;
+    uint32_t slotCount;
+    uint32_t usedRegs[RegClass_SIZE]; // bit of each physical register assigned
+} LinearScan;
+
+// Forward declarations
+struct Ir;
+struct IrInstr;
+
+RegClass linear_scan_regClass(const struct Ir* ir, uint32_t reg);
+
+void linear_scan_allocate(LinearScan* self, const struct Ir* ir, const RegClassInfo classes[RegClass_SIZE], int (*isCall)(const struct IrInstr* instr));
+void linear_scan_free(LinearScan* self);
+
+#endif // LINEAR_SCAN_H
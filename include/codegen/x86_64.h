@@ -0,0 +1,35 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* x86-64 back end, for the SysV ABI (GNU assembler syntax). The program
+* becomes the main function, its registers allocated by linear scan (see
+* linear_scan.h): ints, booleans and strings in general purpose registers,
+* floats in SSE ones. Reads, writes and the string operations call the
+* runtime (runtime/runtime.c), built next to the compiler
+*/
+
+#ifndef X86_64_H
+#define X86_64_H
+
+#include <stdio.h>
+
+// Forward declarations
+struct Ir;
+struct Interner;
+
+void x86_64_emit(const struct Ir* ir, const struct Interner* interner, FILE* out);
+
+// Assembles asmPath and links it with the runtime into exePath, with the system compiler (cc).
+// Returns 0 on success. On failure, prints why: runtime.o missing next to the compiler, cc not
+// found, or cc failing
+int x86_64_link(const char* asmPath, const char* exePath);
+
+#endif // X86_64_H
@@ -0,0 +1,49 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Control flow graph of the basic blocks of an Ir. The edges of all the
+* blocks share one array, in block order: the successors of block b are
+* succs[succStart[b], succStart[b + 1]), and the same for predecessors
+*/
+
+#ifndef CFG_H
+#define CFG_H
+
+#include <stdint.h>
+
+// Largest liveness sets computed, in 64 bit words for all the blocks. Over it, callers take
+// every variable as live everywhere
+#define CFG_MAX_LIVENESS_WORDS (1u << 22)
+
+typedef struct Cfg
+{
+    uint32_t blockCount;
+    uint32_t* succStart; // blockCount + 1 of them
+    uint32_t* succs;
+    uint32_t* predStart;
+    uint32_t* preds;
+} Cfg;
+
+// Forward declarations
+struct Ir;
+
+void cfg_build(Cfg* self, const struct Ir* ir);
+void cfg_free(Cfg* self);
+
+// Marks the blocks reachable from the entry one with 1, the others with 0
+void cfg_reachable(const Cfg* self, uint8_t* reachable);
+
+// Variables live at the start and at the end of each block, as bit sets of
+// (varCount + 63) / 64 words per block, which must come zeroed. Temporaries are only used
+// in the block that sets them, so they are left out
+void cfg_liveness(const Cfg* self, const struct Ir* ir, uint64_t* liveIn, uint64_t* liveOut);
+
+#endif // CFG_H
@@ -0,0 +1,137 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Three address code, generated from the syntax tree of a valid program.
+* Instructions are fixed size and live in one array, grouped in basic
+* blocks: each block is a range of it, ended by a jump or falling through
+* to the next block. Operands are virtual registers, each of a DataType:
+* the declared variables come first, then the temporaries. Booleans are
+* ints, 1 or 0
+*/
+
+#ifndef IR_H
+#define IR_H
+
+#include <stdint.h>
+
+#define IR_NONE UINT32_MAX
+
+typedef uint32_t IrReg;
+
+typedef enum IrOp
+{
+    IrOp_CONST, // dst = constants[a]
+    IrOp_MOV, // dst = a
+    IrOp_TO_FLOAT, // dst = a, an int
+    // dst = a op b. Booleans are added and subtracted as ints, division of ints truncates
+    IrOp_ADD,
+    IrOp_SUB,
+    IrOp_MUL,
+    IrOp_DIV,
+    IrOp_CONCAT, // dst = a followed by b, strings
+    // dst = (a != 0) op (b != 0), 1 or 0 of type
+    IrOp_AND,
+    IrOp_OR,
+    IrOp_NEG, // dst = -a
+    IrOp_NOT, // dst = a == 0
+    // dst = a op b, a boolean, as a and b compare as type (strings by contents)
+    IrOp_EQ,
+    IrOp_NE,
+    IrOp_LT,
+    IrOp_LE,
+    IrOp_GT,
+    IrOp_GE,
+    IrOp_READ, // dst = value of type read from the input
+    IrOp_WRITE, // a to the output
+    // Jumps end their block. The conditional ones fall through to the next block if not
+    // taken. A condition is true if it is not 0 (not empty for strings)
+    IrOp_JUMP, // to block a
+    IrOp_JUMP_IF, // to block b if a is true
+    IrOp_JUMP_IF_NOT, // to block b if a is false
+    IrOp_EXIT,
+
+    // Not to be used, only to get how many ops are
+    IrOp_SIZE
+} IrOp;
+
+typedef struct IrInstr
+{
+    uint8_t op; // IrOp
+    uint8_t type; // DataType of the operation (the one of its operands if they differ from dst)
+    IrReg dst; // IR_NONE if the op has no result
+    uint32_t a; // register, block or constant, as of op
+    uint32_t b;
+} IrInstr;
+
+typedef struct IrBlock
+{
+    uint32_t first; // instruction
+    uint32_t count;
+} IrBlock;
+
+typedef union IrConstant
+{
+    long intVal;
+    double realVal;
+    uint32_t literalId; // Interner id
+} IrConstant;
+
+typedef struct Ir
+{
+    IrInstr* instrs;
+    uint32_t size;
+    uint32_t capacity;
+
+    IrBlock* blocks; // in layout order, the entry one first
+    uint32_t blockCount;
+    uint32_t blockCapacity;
+
+    IrConstant* constants;
+    uint32_t constantCount;
+    uint32_t constantCapacity;
+
+    uint8_t* regTypes; // DataType of each register
+    uint32_t regCount;
+    uint32_t regCapacity;
+    uint32_t varCount; // registers [0, varCount) are the declared variables
+    uint32_t* varSymbols; // Interner id of the name of each variable
+} Ir;
+
+// Forward declarations
+struct Ast;
+struct Interner;
+
+void ir_init(Ir* self);
+void ir_free(Ir* self);
+
+// Appenders, for the generator and the passes rebuilding the code
+IrReg ir_newReg(Ir* self, uint8_t type);
+uint32_t ir_addConstant(Ir* self, IrConstant constant);
+// Ends the last block (if any) at the next instruction, and starts a new one there
+uint32_t ir_newBlock(Ir* self);
+// Appended to the last block
+uint32_t ir_emit(Ir* self, IrOp op, uint8_t type, IrReg dst, uint32_t a, uint32_t b);
+
+// Registers read by instr, at most 2. Returns their count
+unsigned ir_operands(const IrInstr* instr, IrReg regs[2]);
+
+// Code of the program in ast, which must have no errors. Replaces the one in self.
+// Variables start as 0, 0.0 or the empty string, interned to initialize them
+void ir_generate(Ir* self, const struct Ast* ast, struct Interner* interner);
+
+// Removes the unreachable blocks, the branches on constants and the instructions setting
+// registers that are not read afterwards
+void ir_optimize(Ir* self);
+
+const char* ir_op_toString(IrOp op);
+void ir_print(const Ir* self, const struct Interner* interner);
+
+#endif // IR_H
@@ -0,0 +1,36 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* September 2023
+*/
+
+/*
+* Kernels that skip a whole run of chars the lexer would otherwise
+* walk one DFA transition at a time. They use AVX2 when the CPU supports
+* it, SSE2 otherwise, and a scalar loop on other targets (or when compiled
+* with -DCHAR_SCAN_SCALAR). Every path returns the same result.
+*
+* All functions return a pointer to the first char in [cur, end) that
+* stops the run, or end if there is none.
+*/
+
+#ifndef CHAR_SCAN_H
+#define CHAR_SCAN_H
+
+
+// Skips spaces, tabs, '\r' and '\n'
+const char* char_scan_skipBlanks(const char* cur, const char* end);
+// Skips letters, digits and '_'
+const char* char_scan_skipIdentifierChars(const char* cur, const char* end);
+// Finds the '\n' that ends a '//' comment (or a line, see LineTable)
+const char* char_scan_findNewline(const char* cur, const char* end);
+// Finds the '"' that ends a literal, or the (invalid) '\n' inside it
+const char* char_scan_findLiteralEnd(const char* cur, const char* end);
+// Finds the next '*' inside a '/* */' comment
+const char* char_scan_findStar(const char* cur, const char* end);
+
+#endif // CHAR_SCAN_H
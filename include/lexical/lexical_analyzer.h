@@ -11,18 +11,61 @@
 #ifndef LEXICAL_ANALYZER_H
 #define LEXICAL_ANALYZER_H
 
+#include "line_table.h"
 #include "token.h"
 
-#include <glib.h>
+#include <stddef.h>
 
 typedef struct LexicalAnalyzer LexicalAnalyzer;
+// Forward declarations
+struct Diagnostics;
+struct Interner;
+struct TokenBuffer;
 
-LexicalAnalyzer* lexical_analyzer_new(char* filepath);
+// Edit of a source already tokenized: removedLength chars at offset were replaced by
+// the insertedLength chars at offset of the new source
+typedef struct SourceEdit
+{
+    size_t offset;
+    size_t removedLength;
+    size_t insertedLength;
+} SourceEdit;
+
+// Tokens [first, first + oldCount) of the old stream became [first, first + newCount)
+typedef struct TokenRange
+{
+    size_t first;
+    size_t oldCount;
+    size_t newCount;
+} TokenRange;
+
+// Identifiers and literals are interned into interner, which must outlive the tokens
+LexicalAnalyzer* lexical_analyzer_new(char* filepath, struct Interner* interner);
+// Lexes fd (stdin, a pipe...) through a fixed size window, so memory use does not depend
+// on the input size. fd is read until its end, and is not closed
+LexicalAnalyzer* lexical_analyzer_newFromFd(int fd, struct Interner* interner);
 void lexical_analyzer_destroy(LexicalAnalyzer* self);
 
-unsigned lexical_analyzer_getLine(const LexicalAnalyzer* self);
-unsigned lexical_analyzer_getColumn(const LexicalAnalyzer* self);
+// Line and column of a Token.offset. Lines are indexed up to offset on the first call that
+// needs them. A streamed input can only locate its last token, unless it was tokenized at once
+SourcePosition lexical_analyzer_getPosition(LexicalAnalyzer* self, uint32_t offset);
 
+// Errors found by lexical_analyzer_getToken are reported to diagnostics, and lexing goes on
+// after them. Without diagnostics, the first one exits
+void lexical_analyzer_setDiagnostics(LexicalAnalyzer* self, struct Diagnostics* diagnostics);
 Token lexical_analyzer_getToken(LexicalAnalyzer* self);
+// From now on, lexical_analyzer_getToken takes the tokens from a thread lexing the rest of
+// the input, so lexing overlaps with the work of the caller between tokens. Streamed
+// inputs keep being lexed on demand
+void lexical_analyzer_startThread(LexicalAnalyzer* self);
+// Initializes tokens and lexes the rest of the input into it, up to END_OF_FILE.
+// Lexical errors do not exit here: they are stored in the buffer, and lexing goes on
+// after each of them as lexical_analyzer_getToken does
+void lexical_analyzer_tokenizeAll(LexicalAnalyzer* self, struct TokenBuffer* tokens);
+// Updates tokens, a full tokenization of the source before edit, to the tokens of the new
+// source. Lexing restarts at the last token before the edit, and stops as soon as the new
+// tokens line up with the old ones again. interner must be the one
+// the old tokens were lexed with
+TokenRange lexical_analyzer_relex(struct TokenBuffer* tokens, const char* source, size_t sourceSize, const SourceEdit* edit, struct Interner* interner);
 
 #endif // LEXICAL_ANALYZER_H
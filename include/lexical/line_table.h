@@ -0,0 +1,48 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#ifndef LINE_TABLE_H
+#define LINE_TABLE_H
+
+#include <stddef.h>
+
+// Line and column (in bytes) of a source offset, both from 1
+typedef struct SourcePosition
+{
+    unsigned line;
+    unsigned column;
+} SourcePosition;
+
+// Input offsets where lines start. Tokens only carry their offset, and this table turns
+// it into a line and column when a diagnostic needs one. It is built on demand: only
+// the input up to the last offset looked up is scanned for newlines
+typedef struct LineTable
+{
+    size_t* starts; // starts[i] is the offset of line firstLine + i
+    size_t count;
+    size_t capacity;
+    unsigned firstLine; // 1, unless earlier lines were discarded
+    size_t indexedEnd; // the newlines before this offset are all in starts
+} LineTable;
+
+void line_table_init(LineTable* self);
+void line_table_free(LineTable* self);
+
+// Indexes the lines starting up to end. text holds the input from textOffset on, which
+// must not be past indexedEnd (the text between them has to be scanned)
+void line_table_index(LineTable* self, const char* text, size_t textOffset, size_t end);
+// Forgets the lines before the one of offset, which must be indexed. For streamed
+// input, whose text before offset is gone and will not be looked up again
+void line_table_discardBefore(LineTable* self, size_t offset);
+
+// offset must be indexed, and not before a discarded line
+SourcePosition line_table_getPosition(const LineTable* self, size_t offset);
+
+#endif // LINE_TABLE_H
@@ -11,8 +11,10 @@
 #ifndef TOKEN_H
 #define TOKEN_H
 
+#include <stdint.h>
+
 // Forward declarations
-struct SymbolTableKey;
+struct Interner;
 
 typedef enum TokenType
 {
@@ -68,18 +70,19 @@ typedef enum TokenType
 typedef struct Token
 {
     TokenType type;
+    uint32_t offset; // input offset of the first char (the end of input for END_OF_FILE)
     union
     {
         long longVal;
         double doubleVal;
-        const char* literal;
-        char* lex;
+        uint32_t symbolId; // Interner id of an identifier
+        uint32_t literalId; // Interner id of a literal, without the quotes
     };
 } Token;
 
 const char* token_type_toString(TokenType tt);
 const char* token_type_toUserString(TokenType tt);
-char* token_lexemeToString(const Token* t);
+char* token_lexemeToString(const Token* t, const struct Interner* interner);
 void token_destroyLexemeString(char* str);
 
 #endif // TOKEN_H
@@ -0,0 +1,64 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#ifndef TOKEN_BUFFER_H
+#define TOKEN_BUFFER_H
+
+#include "token.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef union TokenPayload
+{
+    long longVal;
+    double doubleVal;
+    uint32_t symbolId;
+    uint32_t literalId;
+} TokenPayload;
+
+// Lexical error found while filling a buffer. Lexing went on after it
+typedef struct TokenBufferError
+{
+    size_t index; // of the first token after the error, which reaching reports it
+    uint32_t offset;
+    char* message; // without position
+} TokenBufferError;
+
+// Whole token stream, stored as parallel arrays indexed by token
+typedef struct TokenBuffer
+{
+    uint8_t* types; // TokenType
+    TokenPayload* payloads;
+    uint32_t* offsets; // Token.offset, lines and columns are found from it on demand
+    size_t size;
+    size_t capacity;
+
+    // In source order
+    TokenBufferError* errors;
+    size_t errorCount;
+    size_t errorCapacity;
+} TokenBuffer;
+
+void token_buffer_init(TokenBuffer* self, size_t initialCapacity);
+void token_buffer_free(TokenBuffer* self);
+void token_buffer_push(TokenBuffer* self, const Token* t);
+// Records an error found before the next token pushed. Takes a copy of message
+void token_buffer_addError(TokenBuffer* self, uint32_t offset, const char* message);
+void token_buffer_removeLastError(TokenBuffer* self);
+// Replaces the count tokens starting at first with every token of replacement. The errors
+// of self from the start of the token at first up to the token after them are replaced by
+// the errors of replacement
+void token_buffer_replace(TokenBuffer* self, size_t first, size_t count, const TokenBuffer* replacement);
+
+Token token_buffer_get(const TokenBuffer* self, size_t index);
+TokenType token_buffer_getType(const TokenBuffer* self, size_t index);
+
+#endif // TOKEN_BUFFER_H
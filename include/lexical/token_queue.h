@@ -0,0 +1,71 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#ifndef TOKEN_QUEUE_H
+#define TOKEN_QUEUE_H
+
+#include "token.h"
+
+#include <stddef.h>
+
+#define TOKEN_QUEUE_CAPACITY 4096 // entries, a power of 2
+#define TOKEN_QUEUE_BATCH 64 // entries published (or released) at once
+#define TOKEN_QUEUE_LINE 64 // bytes of a cache line
+
+// A token, or a lexical error found before the next one
+typedef struct TokenQueueEntry
+{
+    Token token; // for an error, only its offset is set: where it was found
+    char* errorMessage; // NULL for a token. Belongs to whoever popped the entry
+} TokenQueueEntry;
+
+// Lock free ring with one producer thread and one consumer thread. Each side works on
+// private copies of the indexes, and only publishes them every TOKEN_QUEUE_BATCH entries
+// (or before waiting), so the threads seldom touch the same cache lines. A side that
+// cannot go on spins for a while, then yields its processor
+typedef struct TokenQueue
+{
+    TokenQueueEntry* entries;
+    char pad0[TOKEN_QUEUE_LINE];
+
+    // Producer
+    size_t tail; // next entry to write
+    size_t headSeen; // published head, as last read
+    char pad1[TOKEN_QUEUE_LINE];
+
+    // Consumer
+    size_t head; // next entry to read
+    size_t tailSeen;
+    char pad2[TOKEN_QUEUE_LINE];
+
+    // Shared
+    size_t publishedTail;
+    char pad3[TOKEN_QUEUE_LINE];
+    size_t publishedHead;
+    int closed; // by the consumer: the producer must stop
+} TokenQueue;
+
+void token_queue_init(TokenQueue* self);
+// Frees the error messages of entries never popped
+void token_queue_free(TokenQueue* self);
+
+// Producer side. Both return 0, without pushing, once the queue is closed
+int token_queue_push(TokenQueue* self, const Token* t);
+// Takes a copy of message
+int token_queue_pushError(TokenQueue* self, uint32_t offset, const char* message);
+// Publishes the entries pushed so far, e.g. after the last one
+void token_queue_flush(TokenQueue* self);
+
+// Consumer side. Waits for the next entry
+TokenQueueEntry token_queue_pop(TokenQueue* self);
+// The consumer will not pop anymore: a producer waiting for room gives up
+void token_queue_close(TokenQueue* self);
+
+#endif // TOKEN_QUEUE_H
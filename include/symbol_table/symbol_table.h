@@ -9,15 +9,20 @@
 */
 
 /*
-* This file includes functions that wrap around
-* GHashTable to better organize SymbolTable key/value
-* creation and destruction
+* Symbol table: a flat open addressing table from interner ids to
+* entries, stored inline in the slots. Lookups are inlined into the
+* parser, as they run for every identifier in the program.
+*
+* Scopes nest over the class declarations (level 0). The table only holds
+* the innermost visible declaration of each name: declarations made in a
+* scope are recorded in an undo log, and undone when it is exited
 */
 
 #ifndef SYMBOL_TABLE_H
 #define SYMBOL_TABLE_H
 
-#include <glib.h>
+#include <stddef.h>
+#include <stdint.h>
 
 typedef enum DataType
 {
@@ -27,27 +32,78 @@ typedef enum DataType
     DataType_BOOLEAN
 } DataType;
 
-typedef struct SymbolTableKey
-{
-    // TODO: add level to be able to make multiple scopes
-    char* lex;
-} SymbolTableKey;
-
 typedef struct SymbolTableEntry
 {
     DataType dtype;
+    uint32_t level; // of the scope it was declared in
+    uint32_t decl; // AST node of the declaration
     // add more things...
 } SymbolTableEntry;
 
+typedef struct SymbolTableSlot
+{
+    uint32_t key; // interner id of the identifier + 1, 0 = empty slot
+    SymbolTableEntry entry;
+} SymbolTableSlot;
+
+typedef struct SymbolTable
+{
+    // Linear probing, load factor under 1/2
+    SymbolTableSlot* slots;
+    uint32_t slotMask; // slot count - 1, a power of 2 minus 1
+    unsigned shift; // 32 - log2(slot count)
+    uint32_t size;
+
+    uint32_t level; // current scope
+    struct SymbolTableUndo* undo; // declarations of the open scopes, innermost last
+    size_t undoSize;
+    size_t undoCapacity;
+    size_t* scopeStarts; // undoSize when each open scope was entered
+    size_t scopeCapacity;
+} SymbolTable;
+
 const char* data_type_toString(DataType dt);
 const char* data_type_toUserString(DataType dt);
 
-SymbolTableKey* symbol_table_createKey(char* lex);
-SymbolTableEntry* symbol_table_createEntry(DataType dt);
+// Forward declarations
+struct Interner;
+
+SymbolTable* symbol_table_new(void);
+void symbol_table_destroy(SymbolTable* self);
+
+// Fibonacci hashing: interner ids are dense, so they are spread over the table
+// by the top bits of a multiplication instead of filling it in long runs
+static inline uint32_t symbol_table_hash(const SymbolTable* self, uint32_t symbolId)
+{
+    return (uint32_t) ((symbolId * 2654435769u) >> self->shift);
+}
+
+// Entry of symbolId, or NULL if it is not declared. Allocates nothing
+static inline SymbolTableEntry* symbol_table_lookup(const SymbolTable* self, uint32_t symbolId)
+{
+    uint32_t key = symbolId + 1;
+    uint32_t i = symbol_table_hash(self, symbolId);
+    for (;;)
+    {
+        SymbolTableSlot* slot = &self->slots[i];
+        if (slot->key == key)
+            return &slot->entry;
+        if (slot->key == 0)
+            return NULL;
+        i = (i + 1) & self->slotMask;
+    }
+}
+
+// Declares symbolId in the current scope, where it must not be declared yet. An outer
+// declaration is shadowed until the scope is exited. The returned entry, as the ones
+// from symbol_table_lookup, is valid until the next insert or exit
+SymbolTableEntry* symbol_table_insert(SymbolTable* self, uint32_t symbolId, DataType dt);
 
-GHashTable* symbol_table_new();
-void symbol_table_destroy(GHashTable* self);
+// O(1)
+void symbol_table_enterScope(SymbolTable* self);
+// Undoes the declarations of the current scope, O(their count)
+void symbol_table_exitScope(SymbolTable* self);
 
-void symbol_table_print(GHashTable* self);
+void symbol_table_print(const SymbolTable* self, const struct Interner* interner);
 
 #endif // SYMBOL_TABLE_H
@@ -0,0 +1,44 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Evaluation of constant expressions at compile time. The value of a
+* constant expression is the CONSTANT node it is folded into: the parser
+* folds each operator whose operands are constant as it type checks it,
+* and the propagation pass replaces the variables that are known constants
+* by their value, folding what becomes constant.
+*
+* Folding follows what the generated code computes: ints wrap around,
+* their division truncates (and is not folded by 0), chains starting with
+* a division are floats, booleans are ints, 1 or 0
+*/
+
+#ifndef CONSTANT_FOLDING_H
+#define CONSTANT_FOLDING_H
+
+#include "ast/ast.h"
+#include "lexical/token.h"
+#include "symbol_table/symbol_table.h"
+
+// Forward declarations
+struct Interner;
+
+// left op right, of type dt, if both are CONSTANT nodes. The result is stored in dst as a
+// CONSTANT node (keeping its sibling), which may be left itself. Returns whether it folded
+int constant_folding_binary(Ast* ast, AstIndex dst, AstIndex left, TokenType op, AstIndex right, DataType dt, struct Interner* interner);
+// op operand, if it is a CONSTANT node, into dst. Returns whether it folded
+int constant_folding_unary(Ast* ast, AstIndex dst, TokenType op, AstIndex operand);
+
+// Replaces the uses of variables whose only assignment is a constant by it, where the
+// assignment has certainly run, and folds the expressions that become constant. The
+// program in ast must have no errors
+void constant_folding_propagate(Ast* ast, struct Interner* interner);
+
+#endif // CONSTANT_FOLDING_H
@@ -11,13 +11,20 @@
 #ifndef SYNTACTIC_ANALYZER_H
 #define SYNTACTIC_ANALYZER_H
 
-#include <glib.h>
-
 typedef struct SyntacticAnalyzer SyntacticAnalyzer;
 // Forward declarations
+struct Ast;
+struct Diagnostics;
 struct LexicalAnalyzer;
+struct Interner;
+struct SymbolTable;
+struct TokenBuffer;
 
-SyntacticAnalyzer* syntactic_analyzer_new(GHashTable* st, struct LexicalAnalyzer* la);
+// The program is checked against st, and its tree built into ast. Errors are reported to
+// diagnostics, and parsing goes on after them
+SyntacticAnalyzer* syntactic_analyzer_new(struct SymbolTable* st, struct Ast* ast, struct LexicalAnalyzer* la, struct Interner* interner, struct Diagnostics* diagnostics);
+// Parses a stream lexed beforehand by la with lexical_analyzer_tokenizeAll. la locates diagnostics
+SyntacticAnalyzer* syntactic_analyzer_newFromTokens(struct SymbolTable* st, struct Ast* ast, struct LexicalAnalyzer* la, const struct TokenBuffer* tokens, struct Interner* interner, struct Diagnostics* diagnostics);
 void syntactic_analyzer_destroy(SyntacticAnalyzer* self);
 
 void syntactic_analyzer_start(SyntacticAnalyzer* self);
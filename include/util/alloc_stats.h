@@ -0,0 +1,50 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Allocation accounting, built with "make alloc-stats" (-DALLOC_STATS).
+* malloc, calloc and realloc calls from the compiler (not from libc) are
+* wrapped by the linker, and counted with the arena allocations under the
+* current phase. The counts are printed to stderr when the program exits.
+* In other builds the macros below do nothing.
+*/
+
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+typedef enum AllocPhase
+{
+    AllocPhase_SETUP,
+    AllocPhase_TOKENIZE, // --tokenize-all, before parsing
+    AllocPhase_DECLARATIONS,
+    AllocPhase_STATEMENTS,
+    AllocPhase_CODE_GENERATION, // of a valid program, after parsing
+    AllocPhase_TEARDOWN,
+
+    // Not to be used, only to get how many phases are
+    AllocPhase_SIZE
+} AllocPhase;
+
+// Prints the counts on exit
+void alloc_stats_start(void);
+void alloc_stats_setPhase(AllocPhase phase);
+void alloc_stats_countArena(void);
+
+#ifdef ALLOC_STATS
+#define ALLOC_STATS_START() alloc_stats_start()
+#define ALLOC_STATS_PHASE(phase) alloc_stats_setPhase(phase)
+#define ALLOC_STATS_COUNT_ARENA() alloc_stats_countArena()
+#else
+#define ALLOC_STATS_START() do {} while (0)
+#define ALLOC_STATS_PHASE(phase) do {} while (0)
+#define ALLOC_STATS_COUNT_ARENA() do {} while (0)
+#endif
+
+#endif // ALLOC_STATS_H
@@ -0,0 +1,40 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Subsystem an allocation is accounted to
+typedef enum ArenaTag
+{
+    ArenaTag_INTERNER,
+
+    // Not to be used, only to get how many tags are
+    ArenaTag_SIZE
+} ArenaTag;
+
+// Bump allocator for the interned strings of a whole compilation. Nothing is freed one
+// by one: everything goes at once in arena_destroy. Debug builds count the bytes of each
+// tag, and print them on destroy.
+// Growing arrays (the AST, token buffers, the symbol table, the interner's own tables)
+// stay on malloc/realloc, as an arena could not give back their old storage
+typedef struct Arena Arena;
+
+Arena* arena_new(void);
+void arena_destroy(Arena* self);
+
+// size bytes, aligned for any type
+void* arena_alloc(Arena* self, size_t size, ArenaTag tag);
+// Copy of str[0..length), '\0' terminated (not aligned)
+char* arena_allocString(Arena* self, const char* str, size_t length, ArenaTag tag);
+
+#endif // ARENA_H
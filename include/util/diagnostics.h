@@ -0,0 +1,39 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include "util/dstring.h"
+
+#include <stdarg.h>
+
+// Errors reported by the lexer and the parser, kept in a buffer and printed to stderr
+// together. Once maxErrors are reported they are printed and the program exits
+typedef struct Diagnostics
+{
+    DString text;
+    unsigned count;
+    unsigned maxErrors;
+} Diagnostics;
+
+Diagnostics* diagnostics_new(unsigned maxErrors);
+void diagnostics_destroy(Diagnostics* self);
+
+// Adds "Error at line L column C: " followed by the formatted message, which ends in ".\n"
+void diagnostics_report(Diagnostics* self, unsigned line, unsigned column, const char* format, ...);
+void diagnostics_reportV(Diagnostics* self, unsigned line, unsigned column, const char* format, va_list args);
+unsigned diagnostics_count(const Diagnostics* self);
+// Prints the errors reported so far, and empties the buffer
+void diagnostics_flush(Diagnostics* self);
+// Prints the errors reported so far, and exits
+void diagnostics_exit(Diagnostics* self);
+
+#endif // DIAGNOSTICS_H
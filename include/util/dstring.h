@@ -11,21 +11,29 @@
 #ifndef DSTRING_H
 #define DSTRING_H
 
-// Dynamically resized 'C str' style char array
+#define DSTRING_SMALL_CAPACITY 31
+
+// Dynamically resized 'C str' style char array. Strings up to DSTRING_SMALL_CAPACITY
+// chars are kept in the inline buffer, without touching the heap, so a DString
+// must not be copied or moved once initialized
 typedef struct DString
 {
-    char* str;
+    char* str; // small, or a heap buffer
     unsigned length;
     unsigned capacity;
+    char small[DSTRING_SMALL_CAPACITY + 1];
 } DString;
 
 void dstring_init(DString* dstring, unsigned initialCapacity);
 void dstring_free(DString* dstring);
 void dstring_clear(DString* dstring);
 void dstring_appendChar(DString* dstring, char c);
+// Appends str[0..length) at once
+void dstring_appendN(DString* dstring, const char* str, unsigned length);
 // Shrinks the buffer to fit to the stored string, including terminating '\0'
 void dstring_shrinkToFit(DString* dstring);
-// Returns the buffer and allocates a new one, with the provided capacity
-char* dstring_steal(DString* dstring, unsigned newCapacity);
+// Returns the string in a heap buffer owned by the caller, and leaves dstring empty.
+// A heap buffer is handed over as is, and dstring goes back to its inline buffer
+char* dstring_steal(DString* dstring);
 
 #endif // DSTRING_H
@@ -0,0 +1,33 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#ifndef INTERNER_H
+#define INTERNER_H
+
+#include <stdint.h>
+
+// Maps strings to dense 32 bit ids (0, 1, 2... in insertion order).
+// Each distinct string is stored once, in the arena, and stays valid until it is destroyed.
+typedef struct Interner Interner;
+// Forward declarations
+struct Arena;
+
+Interner* interner_new(struct Arena* arena);
+void interner_destroy(Interner* self);
+
+// Returns the id of str[0..length), inserting it if it is new
+uint32_t interner_intern(Interner* self, const char* str, unsigned length);
+// '\0' terminated string of an id
+const char* interner_getString(const Interner* self, uint32_t id);
+unsigned interner_getLength(const Interner* self, uint32_t id);
+// Number of distinct strings
+uint32_t interner_size(const Interner* self);
+
+#endif // INTERNER_H
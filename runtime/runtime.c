@@ -0,0 +1,79 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Runtime of the compiled programs, linked into each of them. Called from
+* the generated code (see codegen/x86_64.c) with the SysV calling
+* convention. Each read takes a line of the input, each write prints its
+* value on a line of its own. Strings are '\0' terminated, and the ones
+* made by concatenation are never freed
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Line of the input without its '\n', empty at the end of the input. Valid until the next call
+const char* _rt_readLine(void)
+{
+    static char* line = NULL;
+    static size_t capacity = 0;
+    ssize_t length = getline(&line, &capacity, stdin);
+    if (length <= 0)
+        return "";
+    if (line[length - 1] == '\n')
+        line[length - 1] = '\0';
+    return line;
+}
+
+long rt_readInt(void)
+{
+    return strtol(_rt_readLine(), NULL, 10);
+}
+
+double rt_readFloat(void)
+{
+    return strtod(_rt_readLine(), NULL);
+}
+
+const char* rt_readString(void)
+{
+    return strdup(_rt_readLine());
+}
+
+void rt_writeInt(long value)
+{
+    printf("%ld\n", value);
+}
+
+void rt_writeFloat(double value)
+{
+    printf("%g\n", value);
+}
+
+void rt_writeString(const char* value)
+{
+    printf("%s\n", value);
+}
+
+const char* rt_concat(const char* a, const char* b)
+{
+    size_t aLength = strlen(a);
+    size_t bLength = strlen(b);
+    char* str = (char*) malloc(aLength + bLength + 1);
+    memcpy(str, a, aLength);
+    memcpy(str + aLength, b, bLength + 1);
+    return str;
+}
+
+int rt_compareStrings(const char* a, const char* b)
+{
+    return strcmp(a, b);
+}
@@ -0,0 +1,155 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "ast/ast.h"
+
+#include "lexical/token.h"
+#include "symbol_table/symbol_table.h"
+#include "util/interner.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define AST_INITIAL_CAPACITY 256
+
+void ast_init(Ast* self)
+{
+    self->nodes = (AstNode*) malloc(AST_INITIAL_CAPACITY * sizeof(AstNode));
+    self->size = 0;
+    self->capacity = AST_INITIAL_CAPACITY;
+}
+
+void ast_free(Ast* self)
+{
+    free(self->nodes);
+}
+
+void ast_reserve(Ast* self, uint32_t capacity)
+{
+    if (capacity > self->capacity)
+    {
+        self->capacity = capacity;
+        self->nodes = (AstNode*) realloc(self->nodes, self->capacity * sizeof(AstNode));
+    }
+}
+
+AstIndex ast_newNode(Ast* self, AstKind kind, uint32_t offset)
+{
+    if (self->size == self->capacity)
+        ast_reserve(self, self->capacity * 2);
+
+    AstIndex index = self->size++;
+    AstNode* node = &self->nodes[index];
+    node->kind = (uint8_t) kind;
+    node->dtype = 0;
+    node->op = 0;
+    node->offset = offset;
+    node->child = AST_NONE;
+    node->sibling = AST_NONE;
+    node->intVal = 0;
+    return index;
+}
+
+AstIndex ast_addChild(Ast* self, AstIndex parent, AstIndex prev, AstIndex child)
+{
+    if (prev == AST_NONE)
+        self->nodes[parent].child = child;
+    else
+        self->nodes[prev].sibling = child;
+    return child;
+}
+
+const char* ast_kind_toString(AstKind kind)
+{
+    static const char* names[AstKind_SIZE] =
+    {
+        [AstKind_PROGRAM] = "PROGRAM",
+        [AstKind_BLOCK] = "BLOCK",
+        [AstKind_DECL] = "DECL",
+        [AstKind_ASSIGN] = "ASSIGN",
+        [AstKind_IF] = "IF",
+        [AstKind_DO] = "DO",
+        [AstKind_READ] = "READ",
+        [AstKind_WRITE] = "WRITE",
+        [AstKind_BINARY] = "BINARY",
+        [AstKind_UNARY] = "UNARY",
+        [AstKind_ID] = "ID",
+        [AstKind_CONSTANT] = "CONSTANT",
+    };
+    assert(kind < AstKind_SIZE);
+    return names[kind];
+}
+
+void _ast_printNode(const Ast* self, const Interner* interner, AstIndex index, int depth)
+{
+    const AstNode* node = &self->nodes[index];
+    printf("%*s%s", depth * 2, "", ast_kind_toString((AstKind) node->kind));
+    switch ((AstKind) node->kind)
+    {
+    case AstKind_PROGRAM:
+        printf(" %s", interner_getString(interner, node->var.symbolId));
+        break;
+    case AstKind_DECL:
+    case AstKind_ASSIGN:
+    case AstKind_READ:
+    case AstKind_ID:
+        printf(" %s", interner_getString(interner, node->var.symbolId));
+        if (node->var.decl != AST_NONE)
+            printf(" #%u %s", node->var.decl, data_type_toUserString((DataType) node->dtype));
+        break;
+    case AstKind_BINARY:
+    case AstKind_UNARY:
+        printf(" %s %s", token_type_toUserString((TokenType) node->op), data_type_toUserString((DataType) node->dtype));
+        break;
+    case AstKind_CONSTANT:
+        if (node->dtype == DataType_INT || node->dtype == DataType_BOOLEAN)
+            printf(" %ld", node->intVal);
+        else if (node->dtype == DataType_FLOAT)
+            printf(" %g", node->realVal);
+        else
+            printf(" \"%s\"", interner_getString(interner, node->literalId));
+        break;
+    default:
+        break;
+    }
+    printf("\n");
+}
+
+// Preorder, without recursion: operator chains make trees as deep as they are long.
+// pending[depth] is the next node to print at each depth of the current path
+void ast_print(const Ast* self, const Interner* interner)
+{
+    if (self->size == 0)
+        return;
+
+    uint32_t capacity = 64;
+    AstIndex* pending = (AstIndex*) malloc(capacity * sizeof(AstIndex));
+    uint32_t size = 0;
+    pending[size++] = 0;
+    while (size > 0)
+    {
+        AstIndex index = pending[size - 1];
+        if (index == AST_NONE)
+        {
+            --size;
+            continue;
+        }
+        _ast_printNode(self, interner, index, (int) (size - 1));
+        pending[size - 1] = self->nodes[index].sibling;
+        if (size == capacity)
+        {
+            capacity *= 2;
+            pending = (AstIndex*) realloc(pending, capacity * sizeof(AstIndex));
+        }
+        pending[size++] = self->nodes[index].child;
+    }
+    free(pending);
+}
@@ -0,0 +1,237 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "codegen/linear_scan.h"
+
+#include "ir/cfg.h"
+#include "ir/ir.h"
+#include "symbol_table/symbol_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Positions: instruction i reads its operands at 2 * i, and sets its result at 2 * i + 1
+
+typedef struct LsActive
+{
+    uint32_t end;
+    uint32_t reg; // virtual
+} LsActive;
+
+typedef struct LsClassState
+{
+    LsActive active[LINEAR_SCAN_MAX_REGS]; // holding a register, by end
+    uint32_t activeCount;
+    uint32_t freeRegs; // bit of each
+    uint32_t allRegs;
+    uint32_t calleeSavedRegs;
+} LsClassState;
+
+RegClass linear_scan_regClass(const Ir* ir, uint32_t reg)
+{
+    return ir->regTypes[reg] == DataType_FLOAT ? RegClass_FLOAT : RegClass_GENERAL;
+}
+
+void _ls_extend(uint32_t* starts, uint32_t* ends, uint32_t reg, uint32_t position)
+{
+    if (position < starts[reg])
+        starts[reg] = position;
+    if (position > ends[reg])
+        ends[reg] = position;
+}
+
+// Whether a call runs while the interval is live, besides reading it or setting it
+int _ls_crossesCall(const uint32_t* calls, uint32_t callCount, uint32_t start, uint32_t end)
+{
+    // First call not before start
+    uint32_t lo = 0;
+    uint32_t hi = callCount;
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (2 * calls[mid] >= start)
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo < callCount && 2 * calls[lo] + 1 < end;
+}
+
+uint32_t _ls_mask(uint32_t count)
+{
+    return count >= 32 ? UINT32_MAX : (1u << count) - 1;
+}
+
+void _ls_insertActive(LsClassState* state, uint32_t end, uint32_t reg)
+{
+    uint32_t i = state->activeCount++;
+    for (; i > 0 && state->active[i - 1].end > end; --i)
+        state->active[i] = state->active[i - 1];
+    state->active[i].end = end;
+    state->active[i].reg = reg;
+}
+
+void _ls_removeActive(LsClassState* state, uint32_t index)
+{
+    memmove(&state->active[index], &state->active[index + 1], (state->activeCount - index - 1) * sizeof(LsActive));
+    --state->activeCount;
+}
+
+void linear_scan_allocate(LinearScan* self, const Ir* ir, const RegClassInfo classes[RegClass_SIZE], int (*isCall)(const IrInstr* instr))
+{
+    uint32_t regCount = ir->regCount;
+    self->locations = (int32_t*) malloc((regCount + 1) * sizeof(int32_t));
+    self->slotCount = 0;
+    memset(self->usedRegs, 0, sizeof(self->usedRegs));
+
+    uint32_t* starts = (uint32_t*) malloc((regCount + 1) * sizeof(uint32_t));
+    uint32_t* ends = (uint32_t*) calloc(regCount + 1, sizeof(uint32_t));
+    memset(starts, 0xFF, (regCount + 1) * sizeof(uint32_t));
+    uint32_t* calls = (uint32_t*) malloc((ir->size + 1) * sizeof(uint32_t));
+    uint32_t callCount = 0;
+    for (uint32_t i = 0; i < ir->size; ++i)
+    {
+        const IrInstr* instr = &ir->instrs[i];
+        IrReg regs[2];
+        unsigned count = ir_operands(instr, regs);
+        for (unsigned k = 0; k < count; ++k)
+            _ls_extend(starts, ends, regs[k], 2 * i);
+        if (instr->dst != IR_NONE)
+            _ls_extend(starts, ends, instr->dst, 2 * i + 1);
+        if (isCall(instr))
+            calls[callCount++] = i;
+    }
+
+    // Variables also span the blocks they are live across
+    uint32_t n = ir->blockCount;
+    size_t words = (ir->varCount + 63) / 64;
+    if ((size_t) n * words <= CFG_MAX_LIVENESS_WORDS)
+    {
+        uint64_t* liveIn = (uint64_t*) calloc(n * words + 1, sizeof(uint64_t));
+        uint64_t* liveOut = (uint64_t*) calloc(n * words + 1, sizeof(uint64_t));
+        Cfg cfg;
+        cfg_build(&cfg, ir);
+        cfg_liveness(&cfg, ir, liveIn, liveOut);
+        cfg_free(&cfg);
+        for (uint32_t b = 0; b < n; ++b)
+        {
+            const IrBlock* block = &ir->blocks[b];
+            for (size_t w = 0; w < words; ++w)
+            {
+                for (uint64_t bits = liveIn[b * words + w]; bits; bits &= bits - 1)
+                    _ls_extend(starts, ends, (uint32_t) (w * 64) + (uint32_t) __builtin_ctzll(bits), 2 * block->first);
+                for (uint64_t bits = liveOut[b * words + w]; bits; bits &= bits - 1)
+                    _ls_extend(starts, ends, (uint32_t) (w * 64) + (uint32_t) __builtin_ctzll(bits), 2 * (block->first + block->count));
+            }
+        }
+        free(liveOut);
+        free(liveIn);
+    }
+    else
+    {
+        for (uint32_t v = 0; v < ir->varCount; ++v)
+        {
+            if (starts[v] != UINT32_MAX)
+            {
+                starts[v] = 0;
+                ends[v] = 2 * ir->size;
+            }
+        }
+    }
+
+    // Counting sort by start
+    uint32_t positionCount = 2 * ir->size + 2;
+    uint32_t* firsts = (uint32_t*) calloc(positionCount + 1, sizeof(uint32_t));
+    uint32_t intervalCount = 0;
+    for (uint32_t r = 0; r < regCount; ++r)
+    {
+        if (starts[r] != UINT32_MAX)
+        {
+            ++firsts[starts[r] + 1];
+            ++intervalCount;
+        }
+    }
+    for (uint32_t p = 1; p <= positionCount; ++p)
+        firsts[p] += firsts[p - 1];
+    uint32_t* order = (uint32_t*) malloc((intervalCount + 1) * sizeof(uint32_t));
+    for (uint32_t r = 0; r < regCount; ++r)
+    {
+        if (starts[r] != UINT32_MAX)
+            order[firsts[starts[r]]++] = r;
+    }
+
+    LsClassState states[RegClass_SIZE];
+    for (int c = 0; c < RegClass_SIZE; ++c)
+    {
+        states[c].activeCount = 0;
+        states[c].allRegs = _ls_mask(classes[c].regCount);
+        states[c].calleeSavedRegs = _ls_mask(classes[c].calleeSaved);
+        states[c].freeRegs = states[c].allRegs;
+    }
+
+    for (uint32_t k = 0; k < intervalCount; ++k)
+    {
+        uint32_t reg = order[k];
+        uint32_t start = starts[reg];
+        uint32_t end = ends[reg];
+        RegClass c = linear_scan_regClass(ir, reg);
+        LsClassState* state = &states[c];
+        while (state->activeCount > 0 && state->active[0].end < start)
+        {
+            state->freeRegs |= 1u << self->locations[state->active[0].reg];
+            _ls_removeActive(state, 0);
+        }
+
+        int crossesCall = _ls_crossesCall(calls, callCount, start, end);
+        uint32_t allowed = crossesCall ? state->calleeSavedRegs : state->allRegs;
+        uint32_t candidates = state->freeRegs & allowed;
+        // Registers preserved by calls are left to the intervals that need them
+        if (candidates & ~state->calleeSavedRegs)
+            candidates &= ~state->calleeSavedRegs;
+        if (candidates)
+        {
+            int physical = __builtin_ctz(candidates);
+            self->locations[reg] = physical;
+            state->freeRegs &= ~(1u << physical);
+            self->usedRegs[c] |= 1u << physical;
+            _ls_insertActive(state, end, reg);
+            continue;
+        }
+
+        // Spill whichever ends last: the new interval, or an active one whose register it
+        // can take
+        uint32_t victim = state->activeCount;
+        while (victim > 0 && !(allowed >> self->locations[state->active[victim - 1].reg] & 1))
+            --victim;
+        if (victim > 0 && state->active[victim - 1].end > end)
+        {
+            uint32_t spilled = state->active[victim - 1].reg;
+            self->locations[reg] = self->locations[spilled];
+            self->locations[spilled] = -1 - (int32_t) self->slotCount++;
+            _ls_removeActive(state, victim - 1);
+            _ls_insertActive(state, end, reg);
+        }
+        else
+        {
+            self->locations[reg] = -1 - (int32_t) self->slotCount++;
+        }
+    }
+
+    free(order);
+    free(firsts);
+    free(calls);
+    free(ends);
+    free(starts);
+}
+
+void linear_scan_free(LinearScan* self)
+{
+    free(self->locations);
+}
@@ -0,0 +1,635 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "codegen/x86_64.h"
+
+#include "codegen/linear_scan.h"
+#include "ir/ir.h"
+#include "symbol_table/symbol_table.h"
+#include "util/interner.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <limits.h> // PATH_MAX
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define X64_CALLEE_SAVED_GPRS 5
+#define X64_LOCATION_SIZE 32
+#define X64_RUNTIME_NAME "runtime.o"
+#define X64_LINKER "cc"
+#define X64_EXEC_FAILED 127 // exit status of the child when cc could not be run, as in the shell
+
+// Allocatable registers, the ones preserved by calls first. rax, rcx, rdx, xmm0 and xmm1
+// are left as scratch, rsp and rbp hold the frame
+static const char* x64_gprs[] = {"%rbx", "%r12", "%r13", "%r14", "%r15", "%rsi", "%rdi", "%r8", "%r9", "%r10", "%r11"};
+static const char* x64_xmms[] = {"%xmm2", "%xmm3", "%xmm4", "%xmm5", "%xmm6", "%xmm7", "%xmm8", "%xmm9", "%xmm10", "%xmm11", "%xmm12", "%xmm13", "%xmm14", "%xmm15"};
+
+// Condition codes of the comparisons of ints, from IrOp_EQ on, and their negations
+static const char* x64_conditions[] = {"e", "ne", "l", "le", "g", "ge"};
+static const char* x64_negatedConditions[] = {"ne", "e", "ge", "g", "le", "l"};
+
+typedef struct X64Emitter
+{
+    const Ir* ir;
+    const Interner* interner;
+    FILE* out;
+    LinearScan ls;
+    uint32_t pushCount; // callee-saved registers pushed by the prologue
+    uint32_t* useCounts; // of each register
+} X64Emitter;
+
+// Instructions calling the runtime
+int _x64_isCall(const IrInstr* instr)
+{
+    switch ((IrOp) instr->op)
+    {
+    case IrOp_READ:
+    case IrOp_WRITE:
+    case IrOp_CONCAT:
+        return 1;
+    case IrOp_EQ:
+    case IrOp_NE:
+        return instr->type == DataType_STRING;
+    default:
+        return 0;
+    }
+}
+
+void _x64_line(X64Emitter* self, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    fputs("    ", self->out);
+    vfprintf(self->out, format, args);
+    fputc('\n', self->out);
+    va_end(args);
+}
+
+int _x64_isFloat(const X64Emitter* self, IrReg reg)
+{
+    return self->ir->regTypes[reg] == DataType_FLOAT;
+}
+
+// Operand naming where reg lives, written in buffer if it is a stack slot
+const char* _x64_location(const X64Emitter* self, IrReg reg, char buffer[X64_LOCATION_SIZE])
+{
+    int32_t location = self->ls.locations[reg];
+    if (location >= 0)
+        return _x64_isFloat(self, reg) ? x64_xmms[location] : x64_gprs[location];
+    uint32_t slot = (uint32_t) (-1 - location);
+    snprintf(buffer, X64_LOCATION_SIZE, "-%u(%%rbp)", 8 * (self->pushCount + 1 + slot));
+    return buffer;
+}
+
+int _x64_isRegister(const char* location)
+{
+    return location[0] == '%';
+}
+
+// Through a scratch register if both are in memory
+void _x64_move(X64Emitter* self, int isFloat, const char* src, const char* dst)
+{
+    if (strcmp(src, dst) == 0)
+        return;
+    if (!_x64_isRegister(src) && !_x64_isRegister(dst))
+    {
+        const char* scratch = isFloat ? "%xmm0" : "%rax";
+        _x64_line(self, "%s %s, %s", isFloat ? "movsd" : "movq", src, scratch);
+        src = scratch;
+    }
+    if (isFloat)
+        _x64_line(self, "%s %s, %s", _x64_isRegister(src) && _x64_isRegister(dst) ? "movapd" : "movsd", src, dst);
+    else
+        _x64_line(self, "movq %s, %s", src, dst);
+}
+
+// dst = a mnemonic b, as two address code
+void _x64_arithmetic(X64Emitter* self, const char* mnemonic, int isFloat, const char* a, const char* b, const char* dst)
+{
+    // Straight into dst, unless it is not a register or holds b
+    const char* target = _x64_isRegister(dst) && strcmp(dst, b) != 0 ? dst : (isFloat ? "%xmm0" : "%rax");
+    _x64_move(self, isFloat, a, target);
+    _x64_line(self, "%s %s, %s", mnemonic, b, target);
+    _x64_move(self, isFloat, target, dst);
+}
+
+// byteRegister = 1 if reg is true, else 0. Clobbers rcx and xmm1
+void _x64_truth(X64Emitter* self, IrReg reg, const char* byteRegister)
+{
+    char buffer[X64_LOCATION_SIZE];
+    const char* location = _x64_location(self, reg, buffer);
+    switch ((DataType) self->ir->regTypes[reg])
+    {
+    case DataType_FLOAT:
+        // Unordered (NaN) is not equal to 0
+        _x64_line(self, "xorpd %%xmm1, %%xmm1");
+        _x64_line(self, "ucomisd %s, %%xmm1", location);
+        _x64_line(self, "setne %s", byteRegister);
+        _x64_line(self, "setp %%cl");
+        _x64_line(self, "orb %%cl, %s", byteRegister);
+        break;
+    case DataType_STRING:
+        _x64_line(self, "movq %s, %%rcx", location);
+        _x64_line(self, "cmpb $0, (%%rcx)");
+        _x64_line(self, "setne %s", byteRegister);
+        break;
+    default:
+        _x64_line(self, "cmpq $0, %s", location);
+        _x64_line(self, "setne %s", byteRegister);
+        break;
+    }
+}
+
+// dst = al, 1 or 0, as its type
+void _x64_storeFlag(X64Emitter* self, IrReg dst)
+{
+    char buffer[X64_LOCATION_SIZE];
+    const char* location = _x64_location(self, dst, buffer);
+    _x64_line(self, "movzbl %%al, %%eax");
+    if (_x64_isFloat(self, dst))
+    {
+        _x64_line(self, "cvtsi2sdl %%eax, %%xmm0");
+        _x64_move(self, 1, "%xmm0", location);
+    }
+    else
+    {
+        _x64_line(self, "movq %%rax, %s", location);
+    }
+}
+
+// Calls the runtime function with a (and b, unless IR_NONE) as arguments
+void _x64_call(X64Emitter* self, const char* function, IrReg a, IrReg b)
+{
+    char aBuffer[X64_LOCATION_SIZE];
+    char bBuffer[X64_LOCATION_SIZE];
+    if (a != IR_NONE)
+    {
+        const char* aLocation = _x64_location(self, a, aBuffer);
+        if (_x64_isFloat(self, a))
+        {
+            _x64_move(self, 1, aLocation, "%xmm0");
+        }
+        else if (b == IR_NONE)
+        {
+            _x64_move(self, 0, aLocation, "%rdi");
+        }
+        else
+        {
+            // a or b may be in the registers of the arguments
+            _x64_move(self, 0, aLocation, "%rax");
+            _x64_move(self, 0, _x64_location(self, b, bBuffer), "%rsi");
+            _x64_move(self, 0, "%rax", "%rdi");
+        }
+    }
+    _x64_line(self, "call %s", function);
+}
+
+// Sets the flags comparing a to b, ints or strings, for x64_conditions
+void _x64_compare(X64Emitter* self, const IrInstr* instr)
+{
+    if (instr->type == DataType_STRING)
+    {
+        _x64_call(self, "rt_compareStrings", instr->a, instr->b);
+        _x64_line(self, "testl %%eax, %%eax");
+        return;
+    }
+    char aBuffer[X64_LOCATION_SIZE];
+    char bBuffer[X64_LOCATION_SIZE];
+    const char* a = _x64_location(self, instr->a, aBuffer);
+    const char* b = _x64_location(self, instr->b, bBuffer);
+    if (!_x64_isRegister(a))
+    {
+        _x64_line(self, "movq %s, %%rax", a);
+        a = "%rax";
+    }
+    _x64_line(self, "cmpq %s, %s", b, a);
+}
+
+// al = a op b, floats. Comparisons with NaN are false, but for NE
+void _x64_compareFloats(X64Emitter* self, const IrInstr* instr)
+{
+    char aBuffer[X64_LOCATION_SIZE];
+    char bBuffer[X64_LOCATION_SIZE];
+    const char* a = _x64_location(self, instr->a, aBuffer);
+    const char* b = _x64_location(self, instr->b, bBuffer);
+    IrOp op = (IrOp) instr->op;
+    // a < b as b > a: above and above or equal are false when unordered
+    if (op == IrOp_LT || op == IrOp_LE)
+    {
+        const char* swap = a;
+        a = b;
+        b = swap;
+    }
+    _x64_move(self, 1, a, "%xmm0");
+    _x64_line(self, "ucomisd %s, %%xmm0", b);
+    switch (op)
+    {
+    case IrOp_EQ:
+        _x64_line(self, "sete %%al");
+        _x64_line(self, "setnp %%cl");
+        _x64_line(self, "andb %%cl, %%al");
+        break;
+    case IrOp_NE:
+        _x64_line(self, "setne %%al");
+        _x64_line(self, "setp %%cl");
+        _x64_line(self, "orb %%cl, %%al");
+        break;
+    case IrOp_LT:
+    case IrOp_GT:
+        _x64_line(self, "seta %%al");
+        break;
+    default: // LE, GE
+        _x64_line(self, "setae %%al");
+        break;
+    }
+}
+
+void _x64_constant(X64Emitter* self, const IrInstr* instr, const char* dst)
+{
+    const IrConstant* constant = &self->ir->constants[instr->a];
+    switch ((DataType) instr->type)
+    {
+    case DataType_FLOAT:
+    {
+        uint64_t bits;
+        memcpy(&bits, &constant->realVal, sizeof(bits));
+        if (bits == 0 && _x64_isRegister(dst))
+        {
+            _x64_line(self, "xorpd %s, %s", dst, dst);
+        }
+        else
+        {
+            const char* target = _x64_isRegister(dst) ? dst : "%xmm0";
+            _x64_line(self, "movsd .LC%u(%%rip), %s", instr->a, target);
+            _x64_move(self, 1, target, dst);
+        }
+        break;
+    }
+    case DataType_STRING:
+    {
+        const char* target = _x64_isRegister(dst) ? dst : "%rax";
+        _x64_line(self, "leaq .LS%u(%%rip), %s", constant->literalId, target);
+        _x64_move(self, 0, target, dst);
+        break;
+    }
+    default:
+        if (constant->intVal >= INT32_MIN && constant->intVal <= INT32_MAX)
+        {
+            _x64_line(self, "movq $%ld, %s", constant->intVal, dst);
+        }
+        else
+        {
+            _x64_line(self, "movabsq $%ld, %%rax", constant->intVal);
+            _x64_move(self, 0, "%rax", dst);
+        }
+        break;
+    }
+}
+
+// Code of instruction i. Returns how many instructions it took: a comparison of ints or
+// strings only read by the jump after it takes both
+uint32_t _x64_instr(X64Emitter* self, uint32_t i, uint32_t blockEnd)
+{
+    const Ir* ir = self->ir;
+    const IrInstr* instr = &ir->instrs[i];
+    IrOp op = (IrOp) instr->op;
+    int isFloat = instr->type == DataType_FLOAT;
+    char aBuffer[X64_LOCATION_SIZE];
+    char bBuffer[X64_LOCATION_SIZE];
+    char dstBuffer[X64_LOCATION_SIZE];
+    const char* a = "";
+    const char* b = "";
+    const char* dst = "";
+    IrReg regs[2];
+    unsigned count = ir_operands(instr, regs);
+    if (count > 0)
+        a = _x64_location(self, regs[0], aBuffer);
+    if (count > 1)
+        b = _x64_location(self, regs[1], bBuffer);
+    if (instr->dst != IR_NONE)
+        dst = _x64_location(self, instr->dst, dstBuffer);
+
+    switch (op)
+    {
+    case IrOp_CONST:
+        _x64_constant(self, instr, dst);
+        break;
+    case IrOp_MOV:
+        _x64_move(self, isFloat, a, dst);
+        break;
+    case IrOp_TO_FLOAT:
+    {
+        const char* target = _x64_isRegister(dst) ? dst : "%xmm0";
+        _x64_line(self, "xorpd %s, %s", target, target); // no dependency on its last value
+        _x64_line(self, "cvtsi2sdq %s, %s", a, target);
+        _x64_move(self, 1, target, dst);
+        break;
+    }
+    case IrOp_ADD:
+        _x64_arithmetic(self, isFloat ? "addsd" : "addq", isFloat, a, b, dst);
+        break;
+    case IrOp_SUB:
+        _x64_arithmetic(self, isFloat ? "subsd" : "subq", isFloat, a, b, dst);
+        break;
+    case IrOp_MUL:
+        _x64_arithmetic(self, isFloat ? "mulsd" : "imulq", isFloat, a, b, dst);
+        break;
+    case IrOp_DIV:
+        if (isFloat)
+        {
+            _x64_arithmetic(self, "divsd", 1, a, b, dst);
+        }
+        else
+        {
+            _x64_line(self, "movq %s, %%rax", a);
+            _x64_line(self, "cqo");
+            _x64_line(self, "idivq %s", b);
+            _x64_move(self, 0, "%rax", dst);
+        }
+        break;
+    case IrOp_CONCAT:
+        _x64_call(self, "rt_concat", instr->a, instr->b);
+        _x64_move(self, 0, "%rax", dst);
+        break;
+    case IrOp_AND:
+    case IrOp_OR:
+        _x64_truth(self, instr->a, "%al");
+        _x64_truth(self, instr->b, "%dl");
+        _x64_line(self, "%s %%dl, %%al", op == IrOp_AND ? "andb" : "orb");
+        _x64_storeFlag(self, instr->dst);
+        break;
+    case IrOp_NEG:
+    {
+        const char* target = _x64_isRegister(dst) ? dst : (isFloat ? "%xmm0" : "%rax");
+        _x64_move(self, isFloat, a, target);
+        if (isFloat)
+            _x64_line(self, "xorpd .LCsign(%%rip), %s", target);
+        else
+            _x64_line(self, "negq %s", target);
+        _x64_move(self, isFloat, target, dst);
+        break;
+    }
+    case IrOp_NOT:
+        _x64_truth(self, instr->a, "%al");
+        _x64_line(self, "xorb $1, %%al");
+        _x64_storeFlag(self, instr->dst);
+        break;
+    case IrOp_EQ:
+    case IrOp_NE:
+    case IrOp_LT:
+    case IrOp_LE:
+    case IrOp_GT:
+    case IrOp_GE:
+    {
+        if (isFloat)
+        {
+            _x64_compareFloats(self, instr);
+            _x64_storeFlag(self, instr->dst);
+            break;
+        }
+        _x64_compare(self, instr);
+        const IrInstr* next = &ir->instrs[i + 1];
+        if (i + 1 < blockEnd && (next->op == IrOp_JUMP_IF || next->op == IrOp_JUMP_IF_NOT) &&
+            next->a == instr->dst && instr->dst >= ir->varCount && self->useCounts[instr->dst] == 1)
+        {
+            const char** conditions = next->op == IrOp_JUMP_IF ? x64_conditions : x64_negatedConditions;
+            _x64_line(self, "j%s .LB%u", conditions[op - IrOp_EQ], next->b);
+            return 2;
+        }
+        _x64_line(self, "set%s %%al", x64_conditions[op - IrOp_EQ]);
+        _x64_storeFlag(self, instr->dst);
+        break;
+    }
+    case IrOp_READ:
+        if (isFloat)
+        {
+            _x64_call(self, "rt_readFloat", IR_NONE, IR_NONE);
+            _x64_move(self, 1, "%xmm0", dst);
+        }
+        else
+        {
+            _x64_call(self, instr->type == DataType_STRING ? "rt_readString" : "rt_readInt", IR_NONE, IR_NONE);
+            _x64_move(self, 0, "%rax", dst);
+        }
+        break;
+    case IrOp_WRITE:
+        if (isFloat)
+            _x64_call(self, "rt_writeFloat", instr->a, IR_NONE);
+        else
+            _x64_call(self, instr->type == DataType_STRING ? "rt_writeString" : "rt_writeInt", instr->a, IR_NONE);
+        break;
+    case IrOp_JUMP:
+        // To the next block, it falls through
+        if (i + 1 >= ir->size || instr->a >= ir->blockCount || ir->blocks[instr->a].first != i + 1)
+            _x64_line(self, "jmp .LB%u", instr->a);
+        break;
+    case IrOp_JUMP_IF:
+    case IrOp_JUMP_IF_NOT:
+    {
+        const char* condition = op == IrOp_JUMP_IF ? "ne" : "e";
+        if (isFloat || instr->type == DataType_STRING)
+        {
+            _x64_truth(self, instr->a, "%al");
+            _x64_line(self, "testb %%al, %%al");
+        }
+        else if (_x64_isRegister(a))
+        {
+            _x64_line(self, "testq %s, %s", a, a);
+        }
+        else
+        {
+            _x64_line(self, "cmpq $0, %s", a);
+        }
+        _x64_line(self, "j%s .LB%u", condition, instr->b);
+        break;
+    }
+    case IrOp_EXIT:
+        if (i + 1 < ir->size)
+            _x64_line(self, "jmp .Lreturn");
+        break;
+    default:
+        assert("Invalid IrOp value" && 0);
+        break;
+    }
+    return 1;
+}
+
+// Escaped for the assembler
+void _x64_string(X64Emitter* self, const char* str)
+{
+    fputs("    .string \"", self->out);
+    for (const unsigned char* c = (const unsigned char*) str; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+            fprintf(self->out, "\\%c", *c);
+        else if (*c < 0x20 || *c >= 0x7F)
+            fprintf(self->out, "\\%03o", *c);
+        else
+            fputc(*c, self->out);
+    }
+    fputs("\"\n", self->out);
+}
+
+// Float constants and string literals loaded by the code
+void _x64_data(X64Emitter* self)
+{
+    const Ir* ir = self->ir;
+    fprintf(self->out, "    .section .rodata\n");
+    fprintf(self->out, "    .align 16\n");
+    fprintf(self->out, ".LCsign:\n"); // xor flips the sign of a float
+    fprintf(self->out, "    .quad 0x8000000000000000, 0\n");
+    fprintf(self->out, "    .align 8\n");
+    uint32_t literalCount = interner_size(self->interner);
+    uint8_t* literalEmitted = (uint8_t*) calloc(literalCount + 1, sizeof(uint8_t));
+    for (uint32_t i = 0; i < ir->size; ++i)
+    {
+        const IrInstr* instr = &ir->instrs[i];
+        if (instr->op != IrOp_CONST)
+            continue;
+        const IrConstant* constant = &ir->constants[instr->a];
+        if (instr->type == DataType_FLOAT)
+        {
+            uint64_t bits;
+            memcpy(&bits, &constant->realVal, sizeof(bits));
+            fprintf(self->out, ".LC%u:\n", instr->a);
+            fprintf(self->out, "    .quad 0x%016" PRIx64 "\n", bits);
+        }
+        else if (instr->type == DataType_STRING && !literalEmitted[constant->literalId])
+        {
+            literalEmitted[constant->literalId] = 1;
+            fprintf(self->out, ".LS%u:\n", constant->literalId);
+            _x64_string(self, interner_getString(self->interner, constant->literalId));
+        }
+    }
+    free(literalEmitted);
+}
+
+void x86_64_emit(const Ir* ir, const Interner* interner, FILE* out)
+{
+    X64Emitter self;
+    self.ir = ir;
+    self.interner = interner;
+    self.out = out;
+
+    RegClassInfo classes[RegClass_SIZE];
+    classes[RegClass_GENERAL].regCount = sizeof(x64_gprs) / sizeof(x64_gprs[0]);
+    classes[RegClass_GENERAL].calleeSaved = X64_CALLEE_SAVED_GPRS;
+    classes[RegClass_FLOAT].regCount = sizeof(x64_xmms) / sizeof(x64_xmms[0]);
+    classes[RegClass_FLOAT].calleeSaved = 0; // none in SysV
+    linear_scan_allocate(&self.ls, ir, classes, _x64_isCall);
+
+    self.useCounts = (uint32_t*) calloc(ir->regCount + 1, sizeof(uint32_t));
+    for (uint32_t i = 0; i < ir->size; ++i)
+    {
+        IrReg regs[2];
+        unsigned count = ir_operands(&ir->instrs[i], regs);
+        for (unsigned k = 0; k < count; ++k)
+            ++self.useCounts[regs[k]];
+    }
+
+    // Frame: rbp, the callee-saved registers used, then the stack slots. Calls need rsp
+    // aligned to 16 bytes, as it is after pushing rbp
+    uint32_t saved = self.ls.usedRegs[RegClass_GENERAL] & ((1u << X64_CALLEE_SAVED_GPRS) - 1);
+    self.pushCount = (uint32_t) __builtin_popcount(saved);
+    uint32_t frameSize = 8 * self.ls.slotCount;
+    if ((8 * self.pushCount + frameSize) % 16 != 0)
+        frameSize += 8;
+
+    fprintf(out, "    .text\n");
+    fprintf(out, "    .globl main\n");
+    fprintf(out, "    .type main, @function\n");
+    fprintf(out, "main:\n");
+    _x64_line(&self, "pushq %%rbp");
+    _x64_line(&self, "movq %%rsp, %%rbp");
+    for (uint32_t r = 0; r < X64_CALLEE_SAVED_GPRS; ++r)
+    {
+        if (saved >> r & 1)
+            _x64_line(&self, "pushq %s", x64_gprs[r]);
+    }
+    if (frameSize > 0)
+        _x64_line(&self, "subq $%u, %%rsp", frameSize);
+
+    for (uint32_t b = 0; b < ir->blockCount; ++b)
+    {
+        const IrBlock* block = &ir->blocks[b];
+        fprintf(out, ".LB%u:\n", b);
+        uint32_t end = block->first + block->count;
+        for (uint32_t i = block->first; i < end;)
+            i += _x64_instr(&self, i, end);
+    }
+
+    fprintf(out, ".Lreturn:\n");
+    _x64_line(&self, "xorl %%eax, %%eax");
+    _x64_line(&self, "leaq -%u(%%rbp), %%rsp", 8 * self.pushCount);
+    for (uint32_t r = X64_CALLEE_SAVED_GPRS; r-- > 0;)
+    {
+        if (saved >> r & 1)
+            _x64_line(&self, "popq %s", x64_gprs[r]);
+    }
+    _x64_line(&self, "popq %%rbp");
+    _x64_line(&self, "ret");
+    fprintf(out, "    .size main, .-main\n");
+
+    _x64_data(&self);
+    fprintf(out, "    .section .note.GNU-stack,\"\",@progbits\n"); // no executable stack
+
+    free(self.useCounts);
+    linear_scan_free(&self.ls);
+}
+
+int x86_64_link(const char* asmPath, const char* exePath)
+{
+    // The runtime is built next to the compiler
+    char runtimePath[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe", runtimePath, sizeof(runtimePath) - sizeof(X64_RUNTIME_NAME));
+    if (length > 0)
+        runtimePath[length] = '\0';
+    char* slash = length <= 0 ? NULL : strrchr(runtimePath, '/');
+    if (slash == NULL)
+    {
+        fprintf(stderr, "Could not find the path of the compiler.\n");
+        return -1;
+    }
+    strcpy(slash + 1, X64_RUNTIME_NAME);
+    if (access(runtimePath, R_OK) != 0)
+    {
+        fprintf(stderr, "Runtime \"%s\" not found, build it with make.\n", runtimePath);
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0)
+    {
+        fprintf(stderr, "Could not run \"" X64_LINKER "\".\n");
+        return -1;
+    }
+    if (pid == 0)
+    {
+        execlp(X64_LINKER, X64_LINKER, "-o", exePath, asmPath, runtimePath, (char*) NULL);
+        _exit(X64_EXEC_FAILED);
+    }
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) == X64_EXEC_FAILED)
+    {
+        fprintf(stderr, "Could not run \"" X64_LINKER "\", is it on the PATH?\n");
+        return -1;
+    }
+    if (WEXITSTATUS(status) != 0)
+    {
+        fprintf(stderr, "\"" X64_LINKER "\" failed linking \"%s\".\n", exePath);
+        return -1;
+    }
+    return 0;
+}
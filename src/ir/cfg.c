@@ -0,0 +1,178 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "ir/cfg.h"
+
+#include "ir/ir.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Successors of block b, at most 2. Returns their count
+unsigned _cfg_successors(const Ir* ir, uint32_t b, uint32_t succs[2])
+{
+    const IrBlock* block = &ir->blocks[b];
+    unsigned count = 0;
+    int fallsThrough = 1;
+    if (block->count > 0)
+    {
+        const IrInstr* last = &ir->instrs[block->first + block->count - 1];
+        switch ((IrOp) last->op)
+        {
+        case IrOp_JUMP:
+            succs[count++] = last->a;
+            fallsThrough = 0;
+            break;
+        case IrOp_JUMP_IF:
+        case IrOp_JUMP_IF_NOT:
+            succs[count++] = last->b;
+            break;
+        case IrOp_EXIT:
+            fallsThrough = 0;
+            break;
+        default:
+            break;
+        }
+    }
+    if (fallsThrough && b + 1 < ir->blockCount && (count == 0 || succs[0] != b + 1))
+        succs[count++] = b + 1;
+    return count;
+}
+
+void cfg_build(Cfg* self, const Ir* ir)
+{
+    uint32_t n = ir->blockCount;
+    self->blockCount = n;
+    self->succStart = (uint32_t*) malloc((n + 1) * sizeof(uint32_t));
+    self->predStart = (uint32_t*) calloc(n + 2, sizeof(uint32_t));
+
+    // Successors in order, counting the predecessors of each block one slot ahead
+    uint32_t edgeCount = 0;
+    for (uint32_t b = 0; b < n; ++b)
+    {
+        uint32_t succs[2];
+        self->succStart[b] = edgeCount;
+        unsigned count = _cfg_successors(ir, b, succs);
+        for (unsigned i = 0; i < count; ++i)
+            ++self->predStart[succs[i] + 2];
+        edgeCount += count;
+    }
+    self->succStart[n] = edgeCount;
+    self->succs = (uint32_t*) malloc((edgeCount + 1) * sizeof(uint32_t));
+    self->preds = (uint32_t*) malloc((edgeCount + 1) * sizeof(uint32_t));
+
+    // Prefix sums: predStart[b + 1] is where the predecessors of b start, and is bumped
+    // as they are placed, ending where they end
+    for (uint32_t b = 2; b <= n + 1; ++b)
+        self->predStart[b] += self->predStart[b - 1];
+    for (uint32_t b = 0; b < n; ++b)
+    {
+        uint32_t succs[2];
+        unsigned count = _cfg_successors(ir, b, succs);
+        for (unsigned i = 0; i < count; ++i)
+        {
+            self->succs[self->succStart[b] + i] = succs[i];
+            self->preds[self->predStart[succs[i] + 1]++] = b;
+        }
+    }
+}
+
+void cfg_free(Cfg* self)
+{
+    free(self->succStart);
+    free(self->succs);
+    free(self->predStart);
+    free(self->preds);
+}
+
+void cfg_reachable(const Cfg* self, uint8_t* reachable)
+{
+    memset(reachable, 0, self->blockCount);
+    if (self->blockCount == 0)
+        return;
+
+    // Each block is pushed once, when first reached
+    uint32_t* stack = (uint32_t*) malloc(self->blockCount * sizeof(uint32_t));
+    uint32_t size = 0;
+    stack[size++] = 0;
+    reachable[0] = 1;
+    while (size > 0)
+    {
+        uint32_t b = stack[--size];
+        for (uint32_t e = self->succStart[b]; e < self->succStart[b + 1]; ++e)
+        {
+            uint32_t succ = self->succs[e];
+            if (!reachable[succ])
+            {
+                reachable[succ] = 1;
+                stack[size++] = succ;
+            }
+        }
+    }
+    free(stack);
+}
+
+void cfg_liveness(const Cfg* self, const Ir* ir, uint64_t* liveIn, uint64_t* liveOut)
+{
+    uint32_t n = self->blockCount;
+    size_t words = (ir->varCount + 63) / 64;
+    // use: variables read before being set in the block, def: the ones it sets
+    uint64_t* use = (uint64_t*) calloc(n * words + 1, sizeof(uint64_t));
+    uint64_t* def = (uint64_t*) calloc(n * words + 1, sizeof(uint64_t));
+    for (uint32_t b = 0; b < n; ++b)
+    {
+        const IrBlock* block = &ir->blocks[b];
+        uint64_t* bUse = &use[b * words];
+        uint64_t* bDef = &def[b * words];
+        for (uint32_t i = block->first; i < block->first + block->count; ++i)
+        {
+            const IrInstr* instr = &ir->instrs[i];
+            IrReg regs[2];
+            unsigned count = ir_operands(instr, regs);
+            for (unsigned k = 0; k < count; ++k)
+            {
+                IrReg r = regs[k];
+                if (r < ir->varCount && !(bDef[r / 64] >> (r % 64) & 1))
+                    bUse[r / 64] |= 1ull << (r % 64);
+            }
+            if (instr->dst < ir->varCount)
+                bDef[instr->dst / 64] |= 1ull << (instr->dst % 64);
+        }
+    }
+
+    // Backwards, until nothing changes: once per nesting level of the loops
+    int changed = 1;
+    while (changed)
+    {
+        changed = 0;
+        for (uint32_t b = n; b-- > 0;)
+        {
+            uint64_t* out = &liveOut[b * words];
+            for (uint32_t e = self->succStart[b]; e < self->succStart[b + 1]; ++e)
+            {
+                const uint64_t* succIn = &liveIn[self->succs[e] * words];
+                for (size_t w = 0; w < words; ++w)
+                    out[w] |= succIn[w];
+            }
+            uint64_t* in = &liveIn[b * words];
+            for (size_t w = 0; w < words; ++w)
+            {
+                uint64_t value = use[b * words + w] | (out[w] & ~def[b * words + w]);
+                if (value != in[w])
+                {
+                    in[w] = value;
+                    changed = 1;
+                }
+            }
+        }
+    }
+    free(def);
+    free(use);
+}
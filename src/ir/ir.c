@@ -0,0 +1,219 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "ir/ir.h"
+
+#include "symbol_table/symbol_table.h"
+#include "util/interner.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define IR_INITIAL_CAPACITY 64
+
+void ir_init(Ir* self)
+{
+    self->instrs = (IrInstr*) malloc(IR_INITIAL_CAPACITY * sizeof(IrInstr));
+    self->size = 0;
+    self->capacity = IR_INITIAL_CAPACITY;
+    self->blocks = (IrBlock*) malloc(IR_INITIAL_CAPACITY * sizeof(IrBlock));
+    self->blockCount = 0;
+    self->blockCapacity = IR_INITIAL_CAPACITY;
+    self->constants = (IrConstant*) malloc(IR_INITIAL_CAPACITY * sizeof(IrConstant));
+    self->constantCount = 0;
+    self->constantCapacity = IR_INITIAL_CAPACITY;
+    self->regTypes = (uint8_t*) malloc(IR_INITIAL_CAPACITY);
+    self->regCount = 0;
+    self->regCapacity = IR_INITIAL_CAPACITY;
+    self->varCount = 0;
+    self->varSymbols = NULL;
+}
+
+void ir_free(Ir* self)
+{
+    free(self->instrs);
+    free(self->blocks);
+    free(self->constants);
+    free(self->regTypes);
+    free(self->varSymbols);
+}
+
+IrReg ir_newReg(Ir* self, uint8_t type)
+{
+    if (self->regCount == self->regCapacity)
+    {
+        self->regCapacity *= 2;
+        self->regTypes = (uint8_t*) realloc(self->regTypes, self->regCapacity);
+    }
+    self->regTypes[self->regCount] = type;
+    return self->regCount++;
+}
+
+uint32_t ir_addConstant(Ir* self, IrConstant constant)
+{
+    if (self->constantCount == self->constantCapacity)
+    {
+        self->constantCapacity *= 2;
+        self->constants = (IrConstant*) realloc(self->constants, self->constantCapacity * sizeof(IrConstant));
+    }
+    self->constants[self->constantCount] = constant;
+    return self->constantCount++;
+}
+
+uint32_t ir_newBlock(Ir* self)
+{
+    if (self->blockCount == self->blockCapacity)
+    {
+        self->blockCapacity *= 2;
+        self->blocks = (IrBlock*) realloc(self->blocks, self->blockCapacity * sizeof(IrBlock));
+    }
+    self->blocks[self->blockCount].first = self->size;
+    self->blocks[self->blockCount].count = 0;
+    return self->blockCount++;
+}
+
+uint32_t ir_emit(Ir* self, IrOp op, uint8_t type, IrReg dst, uint32_t a, uint32_t b)
+{
+    assert(self->blockCount > 0);
+    if (self->size == self->capacity)
+    {
+        self->capacity *= 2;
+        self->instrs = (IrInstr*) realloc(self->instrs, self->capacity * sizeof(IrInstr));
+    }
+    IrInstr* instr = &self->instrs[self->size];
+    instr->op = (uint8_t) op;
+    instr->type = type;
+    instr->dst = dst;
+    instr->a = a;
+    instr->b = b;
+    ++self->blocks[self->blockCount - 1].count;
+    return self->size++;
+}
+
+unsigned ir_operands(const IrInstr* instr, IrReg regs[2])
+{
+    switch ((IrOp) instr->op)
+    {
+    case IrOp_CONST:
+    case IrOp_READ:
+    case IrOp_JUMP:
+    case IrOp_EXIT:
+        return 0;
+    case IrOp_MOV:
+    case IrOp_TO_FLOAT:
+    case IrOp_NEG:
+    case IrOp_NOT:
+    case IrOp_WRITE:
+    case IrOp_JUMP_IF:
+    case IrOp_JUMP_IF_NOT:
+        regs[0] = instr->a;
+        return 1;
+    default: // binary
+        regs[0] = instr->a;
+        regs[1] = instr->b;
+        return 2;
+    }
+}
+
+const char* ir_op_toString(IrOp op)
+{
+    static const char* names[IrOp_SIZE] =
+    {
+        [IrOp_CONST] = "const",
+        [IrOp_MOV] = "mov",
+        [IrOp_TO_FLOAT] = "to_float",
+        [IrOp_ADD] = "add",
+        [IrOp_SUB] = "sub",
+        [IrOp_MUL] = "mul",
+        [IrOp_DIV] = "div",
+        [IrOp_CONCAT] = "concat",
+        [IrOp_AND] = "and",
+        [IrOp_OR] = "or",
+        [IrOp_NEG] = "neg",
+        [IrOp_NOT] = "not",
+        [IrOp_EQ] = "eq",
+        [IrOp_NE] = "ne",
+        [IrOp_LT] = "lt",
+        [IrOp_LE] = "le",
+        [IrOp_GT] = "gt",
+        [IrOp_GE] = "ge",
+        [IrOp_READ] = "read",
+        [IrOp_WRITE] = "write",
+        [IrOp_JUMP] = "jump",
+        [IrOp_JUMP_IF] = "jump_if",
+        [IrOp_JUMP_IF_NOT] = "jump_if_not",
+        [IrOp_EXIT] = "exit",
+    };
+    assert(op < IrOp_SIZE);
+    return names[op];
+}
+
+void _ir_printConstant(const Ir* self, const Interner* interner, uint8_t type, uint32_t constant)
+{
+    const IrConstant* c = &self->constants[constant];
+    if (type == DataType_FLOAT)
+        printf("%.17g", c->realVal);
+    else if (type == DataType_STRING)
+        printf("\"%s\"", interner_getString(interner, c->literalId));
+    else
+        printf("%ld", c->intVal);
+}
+
+void ir_print(const Ir* self, const Interner* interner)
+{
+    for (uint32_t r = 0; r < self->varCount; ++r)
+        printf("r%u %s %s\n", r, data_type_toUserString((DataType) self->regTypes[r]), interner_getString(interner, self->varSymbols[r]));
+
+    for (uint32_t b = 0; b < self->blockCount; ++b)
+    {
+        printf("B%u:\n", b);
+        const IrBlock* block = &self->blocks[b];
+        for (uint32_t i = block->first; i < block->first + block->count; ++i)
+        {
+            const IrInstr* instr = &self->instrs[i];
+            printf("    ");
+            if (instr->dst != IR_NONE)
+                printf("r%u = ", instr->dst);
+            IrOp op = (IrOp) instr->op;
+            printf("%s", ir_op_toString(op));
+            switch (op)
+            {
+            case IrOp_CONST:
+                printf(" %s ", data_type_toUserString((DataType) instr->type));
+                _ir_printConstant(self, interner, instr->type, instr->a);
+                break;
+            case IrOp_MOV:
+            case IrOp_TO_FLOAT:
+            case IrOp_NEG:
+            case IrOp_NOT:
+            case IrOp_WRITE:
+                printf(" %s r%u", data_type_toUserString((DataType) instr->type), instr->a);
+                break;
+            case IrOp_READ:
+                printf(" %s", data_type_toUserString((DataType) instr->type));
+                break;
+            case IrOp_JUMP:
+                printf(" B%u", instr->a);
+                break;
+            case IrOp_JUMP_IF:
+            case IrOp_JUMP_IF_NOT:
+                printf(" %s r%u, B%u", data_type_toUserString((DataType) instr->type), instr->a, instr->b);
+                break;
+            case IrOp_EXIT:
+                break;
+            default: // binary
+                printf(" %s r%u, r%u", data_type_toUserString((DataType) instr->type), instr->a, instr->b);
+                break;
+            }
+            printf("\n");
+        }
+    }
+}
@@ -0,0 +1,370 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "ir/ir.h"
+
+#include "ast/ast.h"
+#include "lexical/token.h"
+#include "symbol_table/symbol_table.h"
+#include "util/interner.h"
+
+#include <assert.h>
+#include <stdlib.h>
+
+// Expression node waiting for its operands to be generated
+typedef struct IgFrame
+{
+    AstIndex node;
+    int expanded; // its operands were pushed
+} IgFrame;
+
+// Statement being generated: the program and blocks go through their children, if and do
+// wait for their blocks to emit the jumps around them
+typedef struct IgStmtFrame
+{
+    AstIndex node;
+    AstIndex next; // child of a block to generate next
+    uint32_t step; // of an if or do, by the blocks generated
+    uint32_t jump; // instruction to patch, or the first IR block of a do body
+} IgStmtFrame;
+
+typedef struct IrGen
+{
+    Ir* ir;
+    const Ast* ast;
+    IrReg* regOf; // register of each DECL and generated expression node
+    uint32_t emptyStringId;
+
+    IgFrame* stack;
+    uint32_t stackSize;
+    uint32_t stackCapacity;
+    IgStmtFrame* stmts;
+    uint32_t stmtSize;
+    uint32_t stmtCapacity;
+} IrGen;
+
+void _ig_push(IrGen* self, AstIndex node)
+{
+    if (self->stackSize == self->stackCapacity)
+    {
+        self->stackCapacity *= 2;
+        self->stack = (IgFrame*) realloc(self->stack, self->stackCapacity * sizeof(IgFrame));
+    }
+    self->stack[self->stackSize].node = node;
+    self->stack[self->stackSize].expanded = 0;
+    ++self->stackSize;
+}
+
+IrReg _ig_toFloat(IrGen* self, IrReg reg)
+{
+    if (self->ir->regTypes[reg] == DataType_FLOAT)
+        return reg;
+    IrReg dst = ir_newReg(self->ir, DataType_FLOAT);
+    ir_emit(self->ir, IrOp_TO_FLOAT, DataType_INT, dst, reg, 0);
+    return dst;
+}
+
+IrOp _ig_binaryOp(TokenType op, DataType dt)
+{
+    switch (op)
+    {
+    case TokenType_EQUALS:
+        return IrOp_EQ;
+    case TokenType_NOT_EQUALS:
+        return IrOp_NE;
+    case TokenType_LOWER:
+        return IrOp_LT;
+    case TokenType_LOWER_EQ:
+        return IrOp_LE;
+    case TokenType_GREATER:
+        return IrOp_GT;
+    case TokenType_GREATER_EQ:
+        return IrOp_GE;
+    case TokenType_ADD:
+        return dt == DataType_STRING ? IrOp_CONCAT : IrOp_ADD;
+    case TokenType_SUB:
+        return IrOp_SUB;
+    case TokenType_MUL:
+        return IrOp_MUL;
+    case TokenType_DIV:
+        return IrOp_DIV;
+    case TokenType_AND:
+        return IrOp_AND;
+    case TokenType_OR:
+        return IrOp_OR;
+    default:
+        assert("Invalid binary operator" && 0);
+        return IrOp_SIZE;
+    }
+}
+
+// Code of node, whose operands are generated already
+IrReg _ig_exprNode(IrGen* self, const AstNode* node)
+{
+    Ir* ir = self->ir;
+    IrReg dst;
+    switch ((AstKind) node->kind)
+    {
+    case AstKind_ID:
+        return self->regOf[node->var.decl];
+    case AstKind_CONSTANT:
+    {
+        IrConstant constant;
+        if (node->dtype == DataType_FLOAT)
+            constant.realVal = node->realVal;
+        else if (node->dtype == DataType_STRING)
+            constant.literalId = node->literalId;
+        else
+            constant.intVal = node->intVal;
+        dst = ir_newReg(ir, node->dtype);
+        ir_emit(ir, IrOp_CONST, node->dtype, dst, ir_addConstant(ir, constant), 0);
+        return dst;
+    }
+    case AstKind_UNARY:
+        dst = ir_newReg(ir, node->dtype);
+        ir_emit(ir, node->op == TokenType_NOT ? IrOp_NOT : IrOp_NEG, node->dtype, dst, self->regOf[node->child], 0);
+        return dst;
+    case AstKind_BINARY:
+    {
+        IrReg a = self->regOf[node->child];
+        IrReg b = self->regOf[self->ast->nodes[node->child].sibling];
+        IrOp op = _ig_binaryOp((TokenType) node->op, (DataType) node->dtype);
+        uint8_t type = node->dtype;
+        if (op >= IrOp_EQ)
+        {
+            type = ir->regTypes[a];
+        }
+        else if (node->dtype == DataType_FLOAT && op <= IrOp_DIV)
+        {
+            // Operands of a chain starting with a division may be ints
+            a = _ig_toFloat(self, a);
+            b = _ig_toFloat(self, b);
+        }
+        dst = ir_newReg(ir, node->dtype);
+        ir_emit(ir, op, type, dst, a, b);
+        return dst;
+    }
+    default:
+        assert("Invalid expression node" && 0);
+        return IR_NONE;
+    }
+}
+
+// Without recursion: operator chains make trees as deep as they are long. Operands are
+// generated left to right, before the operator
+IrReg _ig_expr(IrGen* self, AstIndex root)
+{
+    _ig_push(self, root);
+    while (self->stackSize > 0)
+    {
+        IgFrame* frame = &self->stack[self->stackSize - 1];
+        AstIndex index = frame->node;
+        const AstNode* node = &self->ast->nodes[index];
+        if (!frame->expanded && (node->kind == AstKind_BINARY || node->kind == AstKind_UNARY))
+        {
+            frame->expanded = 1;
+            if (node->kind == AstKind_BINARY)
+                _ig_push(self, self->ast->nodes[node->child].sibling);
+            _ig_push(self, node->child);
+            continue;
+        }
+        --self->stackSize;
+        self->regOf[index] = _ig_exprNode(self, node);
+    }
+    return self->regOf[root];
+}
+
+// DECL, ASSIGN, READ or WRITE
+void _ig_stmt(IrGen* self, AstIndex index)
+{
+    Ir* ir = self->ir;
+    const AstNode* node = &self->ast->nodes[index];
+    switch ((AstKind) node->kind)
+    {
+    case AstKind_DECL:
+    {
+        IrConstant zero;
+        if (node->dtype == DataType_FLOAT)
+            zero.realVal = 0.0;
+        else if (node->dtype == DataType_STRING)
+            zero.literalId = self->emptyStringId;
+        else
+            zero.intVal = 0;
+        ir_emit(ir, IrOp_CONST, node->dtype, self->regOf[index], ir_addConstant(ir, zero), 0);
+        break;
+    }
+    case AstKind_ASSIGN:
+    {
+        IrReg var = self->regOf[node->var.decl];
+        IrReg value = _ig_expr(self, node->child);
+        // A temporary is only set by the last instruction: it can set the variable instead
+        if (value >= ir->varCount && ir->instrs[ir->size - 1].dst == value)
+            ir->instrs[ir->size - 1].dst = var;
+        else
+            ir_emit(ir, IrOp_MOV, node->dtype, var, value, 0);
+        break;
+    }
+    case AstKind_READ:
+    {
+        // A variable never declared is read into a temporary
+        IrReg var = node->var.decl != AST_NONE ? self->regOf[node->var.decl] : ir_newReg(ir, node->dtype);
+        ir_emit(ir, IrOp_READ, ir->regTypes[var], var, 0, 0);
+        break;
+    }
+    case AstKind_WRITE:
+    {
+        IrReg value = _ig_expr(self, node->child);
+        ir_emit(ir, IrOp_WRITE, ir->regTypes[value], IR_NONE, value, 0);
+        break;
+    }
+    default:
+        assert("Invalid statement node" && 0);
+        break;
+    }
+}
+
+void _ig_pushStmt(IrGen* self, AstIndex node)
+{
+    if (self->stmtSize == self->stmtCapacity)
+    {
+        self->stmtCapacity *= 2;
+        self->stmts = (IgStmtFrame*) realloc(self->stmts, self->stmtCapacity * sizeof(IgStmtFrame));
+    }
+    IgStmtFrame* frame = &self->stmts[self->stmtSize++];
+    frame->node = node;
+    frame->next = self->ast->nodes[node].child;
+    frame->step = 0;
+}
+
+// Without recursion, as blocks nest without limit
+void _ig_stmts(IrGen* self, AstIndex root)
+{
+    Ir* ir = self->ir;
+    _ig_pushStmt(self, root);
+    while (self->stmtSize > 0)
+    {
+        IgStmtFrame* frame = &self->stmts[self->stmtSize - 1];
+        const AstNode* node = &self->ast->nodes[frame->node];
+        switch ((AstKind) node->kind)
+        {
+        case AstKind_PROGRAM:
+        case AstKind_BLOCK:
+        {
+            AstIndex child = frame->next;
+            if (child == AST_NONE)
+            {
+                --self->stmtSize;
+                break;
+            }
+            frame->next = self->ast->nodes[child].sibling;
+            AstKind kind = (AstKind) self->ast->nodes[child].kind;
+            if (kind == AstKind_BLOCK || kind == AstKind_IF || kind == AstKind_DO)
+                _ig_pushStmt(self, child);
+            else
+                _ig_stmt(self, child);
+            break;
+        }
+        case AstKind_IF:
+        {
+            AstIndex condition = node->child;
+            AstIndex thenBlock = self->ast->nodes[condition].sibling;
+            AstIndex elseBlock = self->ast->nodes[thenBlock].sibling;
+            if (frame->step == 0)
+            {
+                IrReg value = _ig_expr(self, condition);
+                frame->jump = ir_emit(ir, IrOp_JUMP_IF_NOT, ir->regTypes[value], IR_NONE, value, 0); // to else
+                ir_newBlock(ir);
+                frame->step = 1;
+                _ig_pushStmt(self, thenBlock);
+            }
+            else if (frame->step == 1 && elseBlock != AST_NONE)
+            {
+                uint32_t jumpToEnd = ir_emit(ir, IrOp_JUMP, 0, IR_NONE, 0, 0);
+                ir->instrs[frame->jump].b = ir_newBlock(ir);
+                frame->jump = jumpToEnd;
+                frame->step = 2;
+                _ig_pushStmt(self, elseBlock);
+            }
+            else
+            {
+                if (frame->step == 1)
+                    ir->instrs[frame->jump].b = ir_newBlock(ir);
+                else
+                    ir->instrs[frame->jump].a = ir_newBlock(ir);
+                --self->stmtSize;
+            }
+            break;
+        }
+        case AstKind_DO:
+            if (frame->step == 0)
+            {
+                frame->jump = ir_newBlock(ir); // body
+                frame->step = 1;
+                _ig_pushStmt(self, node->child);
+            }
+            else
+            {
+                IrReg value = _ig_expr(self, self->ast->nodes[node->child].sibling);
+                ir_emit(ir, IrOp_JUMP_IF, ir->regTypes[value], IR_NONE, value, frame->jump);
+                ir_newBlock(ir);
+                --self->stmtSize;
+            }
+            break;
+        default:
+            assert("Invalid statement node" && 0);
+            break;
+        }
+    }
+}
+
+void ir_generate(Ir* self, const Ast* ast, Interner* interner)
+{
+    ir_free(self);
+    ir_init(self);
+    if (ast->size == 0)
+        return;
+
+    IrGen gen;
+    gen.ir = self;
+    gen.ast = ast;
+    gen.regOf = (IrReg*) malloc(ast->size * sizeof(IrReg));
+    gen.emptyStringId = interner_intern(interner, "", 0);
+    gen.stackCapacity = 64;
+    gen.stack = (IgFrame*) malloc(gen.stackCapacity * sizeof(IgFrame));
+    gen.stackSize = 0;
+    gen.stmtCapacity = 64;
+    gen.stmts = (IgStmtFrame*) malloc(gen.stmtCapacity * sizeof(IgStmtFrame));
+    gen.stmtSize = 0;
+
+    // Variables get the first registers, in declaration order
+    for (AstIndex i = 0; i < ast->size; ++i)
+    {
+        if (ast->nodes[i].kind == AstKind_DECL)
+            ++self->varCount;
+    }
+    self->varSymbols = (uint32_t*) malloc((self->varCount + 1) * sizeof(uint32_t));
+    for (AstIndex i = 0; i < ast->size; ++i)
+    {
+        const AstNode* node = &ast->nodes[i];
+        if (node->kind == AstKind_DECL)
+        {
+            gen.regOf[i] = ir_newReg(self, node->dtype);
+            self->varSymbols[gen.regOf[i]] = node->var.symbolId;
+        }
+    }
+
+    ir_newBlock(self);
+    _ig_stmts(&gen, 0);
+    ir_emit(self, IrOp_EXIT, 0, IR_NONE, 0, 0);
+
+    free(gen.stmts);
+    free(gen.stack);
+    free(gen.regOf);
+}
@@ -0,0 +1,260 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "ir/ir.h"
+
+#include "ir/cfg.h"
+#include "symbol_table/symbol_table.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Each pass may enable the others: they are repeated while they change something, at most
+// this many times
+#define IO_MAX_ROUNDS 8
+
+typedef struct IrOptimizer
+{
+    Ir* ir;
+    uint8_t* removed; // of each instruction
+    uint8_t* keep; // of each block
+    // Liveness of each register while scanning a block backwards, valid if its stamp is
+    // the one of the block. Otherwise it is the one at the end of the block
+    uint8_t* live;
+    uint32_t* stamps;
+    uint32_t stamp;
+} IrOptimizer;
+
+// Drops the removed instructions and the blocks not kept. Jumps to a dropped block, which
+// must be empty, go to the next kept one, where it fell through
+void _io_compact(IrOptimizer* self)
+{
+    Ir* ir = self->ir;
+    uint32_t* newIndex = (uint32_t*) malloc((ir->blockCount + 1) * sizeof(uint32_t));
+    uint32_t keptCount = 0;
+    for (uint32_t b = 0; b < ir->blockCount; ++b)
+    {
+        if (self->keep[b])
+            newIndex[b] = keptCount++;
+    }
+    uint32_t nextKept = IR_NONE;
+    for (uint32_t b = ir->blockCount; b-- > 0;)
+    {
+        if (self->keep[b])
+            nextKept = newIndex[b];
+        else
+            newIndex[b] = nextKept;
+    }
+
+    uint32_t size = 0;
+    uint32_t blockCount = 0;
+    for (uint32_t b = 0; b < ir->blockCount; ++b)
+    {
+        if (!self->keep[b])
+            continue;
+        uint32_t first = size;
+        const IrBlock* block = &ir->blocks[b];
+        for (uint32_t i = block->first; i < block->first + block->count; ++i)
+        {
+            if (self->removed[i])
+                continue;
+            IrInstr* instr = &ir->instrs[size++];
+            *instr = ir->instrs[i];
+            if (instr->op == IrOp_JUMP)
+                instr->a = newIndex[instr->a];
+            else if (instr->op == IrOp_JUMP_IF || instr->op == IrOp_JUMP_IF_NOT)
+                instr->b = newIndex[instr->b];
+        }
+        ir->blocks[blockCount].first = first;
+        ir->blocks[blockCount].count = size - first;
+        ++blockCount;
+    }
+    ir->size = size;
+    ir->blockCount = blockCount;
+    memset(self->removed, 0, ir->size);
+    memset(self->keep, 1, ir->blockCount);
+    free(newIndex);
+}
+
+// As a condition of the generated code: NaN is true. -1 if not known (strings)
+int _io_isTrue(const Ir* ir, const IrInstr* constant)
+{
+    const IrConstant* c = &ir->constants[constant->a];
+    if (constant->type == DataType_FLOAT)
+        return islessgreater(c->realVal, 0.0) || isunordered(c->realVal, 0.0);
+    if (constant->type == DataType_STRING)
+        return -1;
+    return c->intVal != 0;
+}
+
+// Jumps to the next block are dropped, and conditional ones on a constant set in their
+// block become a jump or nothing
+int _io_simplifyBranches(IrOptimizer* self)
+{
+    Ir* ir = self->ir;
+    int changed = 0;
+    for (uint32_t b = 0; b < ir->blockCount; ++b)
+    {
+        const IrBlock* block = &ir->blocks[b];
+        if (block->count == 0)
+            continue;
+        uint32_t last = block->first + block->count - 1;
+        IrInstr* jump = &ir->instrs[last];
+        if (jump->op == IrOp_JUMP)
+        {
+            if (jump->a == b + 1)
+            {
+                self->removed[last] = 1;
+                changed = 1;
+            }
+            continue;
+        }
+        if (jump->op != IrOp_JUMP_IF && jump->op != IrOp_JUMP_IF_NOT)
+            continue;
+        if (jump->b == b + 1)
+        {
+            self->removed[last] = 1;
+            changed = 1;
+            continue;
+        }
+
+        uint32_t def = last;
+        while (def > block->first && ir->instrs[def - 1].dst != jump->a)
+            --def;
+        if (def == block->first || ir->instrs[def - 1].op != IrOp_CONST)
+            continue;
+        int isTrue = _io_isTrue(ir, &ir->instrs[def - 1]);
+        if (isTrue < 0)
+            continue;
+        if (isTrue == (jump->op == IrOp_JUMP_IF))
+        {
+            jump->op = IrOp_JUMP;
+            jump->type = 0;
+            jump->a = jump->b;
+            jump->b = 0;
+        }
+        else
+        {
+            self->removed[last] = 1;
+        }
+        changed = 1;
+    }
+    return changed;
+}
+
+// Drops the blocks that cannot run, and the empty ones
+int _io_removeBlocks(IrOptimizer* self)
+{
+    Ir* ir = self->ir;
+    Cfg cfg;
+    cfg_build(&cfg, ir);
+    cfg_reachable(&cfg, self->keep);
+    cfg_free(&cfg);
+
+    int changed = 0;
+    for (uint32_t b = 0; b < ir->blockCount; ++b)
+    {
+        if (ir->blocks[b].count == 0)
+            self->keep[b] = 0;
+        changed |= !self->keep[b];
+    }
+    return changed;
+}
+
+// Values written to registers that are not read before they are written again or the
+// program ends
+int _io_removeDeadStores(IrOptimizer* self)
+{
+    Ir* ir = self->ir;
+    uint32_t n = ir->blockCount;
+    size_t words = (ir->varCount + 63) / 64;
+    // Without liveness, every variable is taken as live at the end of each block: only the
+    // stores overwritten in their own block are removed
+    int conservative = (size_t) n * words > CFG_MAX_LIVENESS_WORDS;
+    uint64_t* liveOut = (uint64_t*) calloc(conservative ? words : n * words + 1, sizeof(uint64_t));
+    if (conservative)
+    {
+        memset(liveOut, 0xFF, words * sizeof(uint64_t));
+    }
+    else
+    {
+        uint64_t* liveIn = (uint64_t*) calloc(n * words + 1, sizeof(uint64_t));
+        Cfg cfg;
+        cfg_build(&cfg, ir);
+        cfg_liveness(&cfg, ir, liveIn, liveOut);
+        cfg_free(&cfg);
+        free(liveIn);
+    }
+
+    int changed = 0;
+    for (uint32_t b = 0; b < n; ++b)
+    {
+        const IrBlock* block = &ir->blocks[b];
+        const uint64_t* out = &liveOut[conservative ? 0 : b * words];
+        ++self->stamp;
+        for (uint32_t i = block->first + block->count; i-- > block->first;)
+        {
+            const IrInstr* instr = &ir->instrs[i];
+            IrReg dst = instr->dst;
+            if (dst != IR_NONE)
+            {
+                int isLive = self->stamps[dst] == self->stamp ? self->live[dst] : dst < ir->varCount && (out[dst / 64] >> (dst % 64) & 1);
+                // Reads consume the input, and int divisions may trap
+                if (!isLive && instr->op != IrOp_READ && !(instr->op == IrOp_DIV && instr->type != DataType_FLOAT))
+                {
+                    self->removed[i] = 1;
+                    changed = 1;
+                    continue;
+                }
+                self->stamps[dst] = self->stamp;
+                self->live[dst] = 0;
+            }
+            IrReg regs[2];
+            unsigned count = ir_operands(instr, regs);
+            for (unsigned k = 0; k < count; ++k)
+            {
+                self->stamps[regs[k]] = self->stamp;
+                self->live[regs[k]] = 1;
+            }
+        }
+    }
+    free(liveOut);
+    return changed;
+}
+
+void ir_optimize(Ir* self)
+{
+    IrOptimizer opt;
+    opt.ir = self;
+    opt.removed = (uint8_t*) calloc(self->size + 1, 1);
+    opt.keep = (uint8_t*) malloc(self->blockCount + 1);
+    memset(opt.keep, 1, self->blockCount + 1);
+    opt.live = (uint8_t*) malloc(self->regCount + 1);
+    opt.stamps = (uint32_t*) calloc(self->regCount + 1, sizeof(uint32_t));
+    opt.stamp = 0;
+
+    for (int round = 0; round < IO_MAX_ROUNDS; ++round)
+    {
+        int changed = _io_simplifyBranches(&opt);
+        _io_compact(&opt);
+        changed |= _io_removeBlocks(&opt);
+        _io_compact(&opt);
+        changed |= _io_removeDeadStores(&opt);
+        _io_compact(&opt);
+        if (!changed)
+            break;
+    }
+
+    free(opt.stamps);
+    free(opt.live);
+    free(opt.keep);
+    free(opt.removed);
+}
@@ -0,0 +1,239 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* September 2023
+*/
+
+#include "lexical/char_scan.h"
+
+#include <stddef.h>
+
+#if !defined(CHAR_SCAN_SCALAR) && defined(__SSE2__) && defined(__GNUC__)
+#define CHAR_SCAN_SSE2
+#include <immintrin.h>
+#if defined(__x86_64__) || defined(__i386__)
+#define CHAR_SCAN_AVX2 // compiled for the AVX2 target and chosen at runtime
+#endif
+#endif
+
+typedef enum CharScanKind
+{
+    CharScanKind_BLANKS,
+    CharScanKind_IDENTIFIER,
+    CharScanKind_NEWLINE,
+    CharScanKind_LITERAL_END,
+    CharScanKind_STAR
+} CharScanKind;
+
+static inline int _cs_isStop(CharScanKind kind, char c)
+{
+    switch (kind)
+    {
+    case CharScanKind_BLANKS:
+        return !(c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    case CharScanKind_IDENTIFIER:
+        return !((c >= 'a' && c <= 'z') ||
+                 (c >= 'A' && c <= 'Z') ||
+                 (c >= '0' && c <= '9') ||
+                 c == '_');
+    case CharScanKind_NEWLINE:
+        return c == '\n';
+    case CharScanKind_LITERAL_END:
+        return c == '"' || c == '\n';
+    case CharScanKind_STAR:
+        return c == '*';
+    default:
+        return 1;
+    }
+}
+
+static inline const char* _cs_scanScalar(CharScanKind kind, const char* cur, const char* end)
+{
+    while (cur != end && !_cs_isStop(kind, *cur))
+        ++cur;
+    return cur;
+}
+
+#ifdef CHAR_SCAN_SSE2
+
+// Bytes in [lo, hi]. Bytes >= 0x80 compare as negative, so they are never inside
+static inline __m128i _cs_inRangeSse2(__m128i v, char lo, char hi)
+{
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char) (lo - 1))),
+                         _mm_cmpgt_epi8(_mm_set1_epi8((char) (hi + 1)), v));
+}
+
+static inline unsigned _cs_stopMaskSse2(CharScanKind kind, __m128i v)
+{
+    __m128i m;
+    switch (kind)
+    {
+    case CharScanKind_BLANKS:
+        m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                         _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+        return ~(unsigned) _mm_movemask_epi8(m) & 0xFFFFu;
+    case CharScanKind_IDENTIFIER:
+    {
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20)); // 'A'-'Z' -> 'a'-'z'
+        m = _mm_or_si128(_mm_or_si128(_cs_inRangeSse2(lower, 'a', 'z'), _cs_inRangeSse2(v, '0', '9')),
+                         _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+        return ~(unsigned) _mm_movemask_epi8(m) & 0xFFFFu;
+    }
+    case CharScanKind_NEWLINE:
+        return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    case CharScanKind_LITERAL_END:
+        m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        return (unsigned) _mm_movemask_epi8(m);
+    case CharScanKind_STAR:
+        return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+    default:
+        return 1;
+    }
+}
+
+static inline const char* _cs_scanSse2(CharScanKind kind, const char* cur, const char* end)
+{
+    while (end - cur >= 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (const void*) cur);
+        unsigned stop = _cs_stopMaskSse2(kind, v);
+        if (stop)
+            return cur + __builtin_ctz(stop);
+        cur += 16;
+    }
+    return _cs_scanScalar(kind, cur, end);
+}
+
+#endif // CHAR_SCAN_SSE2
+
+#ifdef CHAR_SCAN_AVX2
+
+#define _CS_AVX2 __attribute__((target("avx2")))
+
+static inline _CS_AVX2 __m256i _cs_inRangeAvx2(__m256i v, char lo, char hi)
+{
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8((char) (lo - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (hi + 1)), v));
+}
+
+static inline _CS_AVX2 unsigned _cs_stopMaskAvx2(CharScanKind kind, __m256i v)
+{
+    __m256i m;
+    switch (kind)
+    {
+    case CharScanKind_BLANKS:
+        m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+        return ~(unsigned) _mm256_movemask_epi8(m);
+    case CharScanKind_IDENTIFIER:
+    {
+        __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        m = _mm256_or_si256(_mm256_or_si256(_cs_inRangeAvx2(lower, 'a', 'z'), _cs_inRangeAvx2(v, '0', '9')),
+                            _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+        return ~(unsigned) _mm256_movemask_epi8(m);
+    }
+    case CharScanKind_NEWLINE:
+        return (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+    case CharScanKind_LITERAL_END:
+        m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        return (unsigned) _mm256_movemask_epi8(m);
+    case CharScanKind_STAR:
+        return (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('*')));
+    default:
+        return 1;
+    }
+}
+
+static inline _CS_AVX2 const char* _cs_scanAvx2(CharScanKind kind, const char* cur, const char* end)
+{
+    while (end - cur >= 32)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (const void*) cur);
+        unsigned stop = _cs_stopMaskAvx2(kind, v);
+        if (stop)
+            return cur + __builtin_ctz(stop);
+        cur += 32;
+    }
+    return _cs_scanSse2(kind, cur, end);
+}
+
+// Specialized per kind, so the kind switch is resolved at compile time
+_CS_AVX2 const char* _cs_blanksAvx2(const char* cur, const char* end)
+{
+    return _cs_scanAvx2(CharScanKind_BLANKS, cur, end);
+}
+
+_CS_AVX2 const char* _cs_identifierAvx2(const char* cur, const char* end)
+{
+    return _cs_scanAvx2(CharScanKind_IDENTIFIER, cur, end);
+}
+
+_CS_AVX2 const char* _cs_newlineAvx2(const char* cur, const char* end)
+{
+    return _cs_scanAvx2(CharScanKind_NEWLINE, cur, end);
+}
+
+_CS_AVX2 const char* _cs_literalEndAvx2(const char* cur, const char* end)
+{
+    return _cs_scanAvx2(CharScanKind_LITERAL_END, cur, end);
+}
+
+_CS_AVX2 const char* _cs_starAvx2(const char* cur, const char* end)
+{
+    return _cs_scanAvx2(CharScanKind_STAR, cur, end);
+}
+
+// -1 while unknown, then 0 or 1
+int _cs_hasAvx2 = -1;
+
+static inline int _cs_useAvx2(void)
+{
+    if (_cs_hasAvx2 < 0)
+    {
+        __builtin_cpu_init();
+        _cs_hasAvx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return _cs_hasAvx2;
+}
+
+#define _CS_DISPATCH(kind, avx2Func, cur, end) \
+    (_cs_useAvx2() ? avx2Func(cur, end) : _cs_scanSse2(kind, cur, end))
+
+#elif defined(CHAR_SCAN_SSE2)
+
+#define _CS_DISPATCH(kind, avx2Func, cur, end) _cs_scanSse2(kind, cur, end)
+
+#else
+
+#define _CS_DISPATCH(kind, avx2Func, cur, end) _cs_scanScalar(kind, cur, end)
+
+#endif // CHAR_SCAN_AVX2
+
+const char* char_scan_skipBlanks(const char* cur, const char* end)
+{
+    return _CS_DISPATCH(CharScanKind_BLANKS, _cs_blanksAvx2, cur, end);
+}
+
+const char* char_scan_skipIdentifierChars(const char* cur, const char* end)
+{
+    return _CS_DISPATCH(CharScanKind_IDENTIFIER, _cs_identifierAvx2, cur, end);
+}
+
+const char* char_scan_findNewline(const char* cur, const char* end)
+{
+    return _CS_DISPATCH(CharScanKind_NEWLINE, _cs_newlineAvx2, cur, end);
+}
+
+const char* char_scan_findLiteralEnd(const char* cur, const char* end)
+{
+    return _CS_DISPATCH(CharScanKind_LITERAL_END, _cs_literalEndAvx2, cur, end);
+}
+
+const char* char_scan_findStar(const char* cur, const char* end)
+{
+    return _CS_DISPATCH(CharScanKind_STAR, _cs_starAvx2, cur, end);
+}
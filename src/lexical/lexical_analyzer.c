@@ -9,535 +9,666 @@
 */
 
 #include "debug.h"
+#include "lexical/char_scan.h"
 #include "lexical/lexical_analyzer.h"
+#include "lexical/line_table.h"
+#include "lexical_dfa_table.h" // generated from DFA/lexical_DFA.dot
 #include "lexical/token.h"
+#include "lexical/token_buffer.h"
+#include "lexical/token_queue.h"
 #include "symbol_table/symbol_table.h"
+#include "util/diagnostics.h"
 #include "util/dstring.h"
+#include "util/interner.h"
 
 #include <assert.h>
-#include <glib.h> // GHashTable
+#include <errno.h>
+#include <fcntl.h> // open
+#include <float.h> // DBL_MAX, FLT_EVAL_METHOD
+#include <limits.h> // LONG_MAX
+#include <pthread.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h> // memcmp
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // read, close
 
 #define LA_INITIAL_LEX_CAPACITY 30
+#define LA_STREAM_WINDOW_SIZE 65536
+#define LA_RUN_THRESHOLD 4
+#define LA_ERROR_MESSAGE_SIZE 256
+#define LA_MAX_SHOWN_CONSTANT 64 // chars of an out of range constant shown in the error
+#define LA_BYTES_PER_TOKEN_ESTIMATE 8 // initial token buffer capacity, real code averages ~5
+#define LA_RELEX_INITIAL_CAPACITY 64
 
 struct LexicalAnalyzer
 {
-    unsigned line;
-    unsigned column;
     DString lex;
-    FILE* file;
 
-    GHashTable* reservedSymbols; // hashmap string (reserved symbols) -> TokenType
-    GHashTable* literals; // Used as a set to existing literals, to avoid duplicating strings on memory
-};
+    // Either the whole mapped file, or a window over a streamed fd
+    const char* source;
+    char* buffer; // owned memory behind source: the mapping or the window. NULL if borrowed
+    size_t sourceSize;
+    int isMapped;
+    const char* cur; // next char to be read
+    const char* end; // one past the last char
 
-void _la_insertTokenTypeIntoHash(GHashTable* hash, char* key, TokenType tt)
-{
-    TokenType* ttPtr = (TokenType*) malloc(sizeof(TokenType));
-    *ttPtr = tt;
-    g_hash_table_insert(hash, key, ttPtr);
+    int fd; // streamed input, -1 once read to the end (or if the whole file is mapped)
+    int ownsFd;
+    size_t sourceOffset; // input offset of source[0]
 
-    DEBUG_PRINT("Inserted \"%s\" into hash.\n", token_type_toString(tt));
-}
+    // Line starts, indexed when a position is asked for (or when streamed text is dropped).
+    // Range lexers have none: their errors are deferred, and located by the caller
+    LineTable lines;
+    int keepsAllLines; // for streams: 0 if positions are only asked for the current token
 
-void _la_initReservedSymbols(GHashTable* reservedSymbols)
+    Interner* interner; // identifiers and literals, so each distinct string is stored once
+
+    Diagnostics* diagnostics; // if set, on demand lexing goes on after an error
+    TokenBuffer* errorTokens; // tokenizing at once: errors are stored with the tokens, and lexing goes on
+    TokenQueue* errorQueue; // lexer thread: errors are pushed in band, and lexing goes on
+    char errorMessage[LA_ERROR_MESSAGE_SIZE];
+
+    struct LaPipeline* pipeline; // if set, tokens are lexed on a thread, and popped from it
+};
+
+// Lexer thread of lexical_analyzer_startThread
+typedef struct LaPipeline
+{
+    LexicalAnalyzer lexer; // interner-less, over the rest of the source
+    TokenQueue queue;
+    pthread_t thread;
+    int reachedEnd; // END_OF_FILE was popped, and is returned from then on
+    Token end;
+} LaPipeline;
+
+// Reserved words, placed by a perfect hash on the length and the first two chars:
+// (2 * s[0] + 7 * s[1] + 3 * length) % 16 is different for every keyword.
+// Adding a keyword requires new hash coefficients (checked by _la_checkKeywordTable).
+#define LA_KEYWORD_SLOTS 16
+#define LA_KEYWORD_MIN_LENGTH 2
+#define LA_KEYWORD_MAX_LENGTH 6
+#define LA_KEYWORD_HASH(s, length) \
+    ((2u * (unsigned char) (s)[0] + 7u * (unsigned char) (s)[1] + 3u * (length)) % LA_KEYWORD_SLOTS)
+
+typedef struct LaKeyword
 {
-    _la_insertTokenTypeIntoHash(reservedSymbols, "class", TokenType_CLASS);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "int", TokenType_INT);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "string", TokenType_STRING);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "float", TokenType_FLOAT);
+    const char* str;
+    unsigned length;
+    TokenType type;
+} LaKeyword;
 
-    _la_insertTokenTypeIntoHash(reservedSymbols, "if", TokenType_IF);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "else", TokenType_ELSE);
+static const LaKeyword la_keywords[LA_KEYWORD_SLOTS] =
+{
+    [9] = {"class", 5, TokenType_CLASS},
+    [13] = {"int", 3, TokenType_INT},
+    [4] = {"string", 6, TokenType_STRING},
+    [15] = {"float", 5, TokenType_FLOAT},
+    [2] = {"if", 2, TokenType_IF},
+    [10] = {"else", 4, TokenType_ELSE},
+    [7] = {"do", 2, TokenType_DO},
+    [5] = {"while", 5, TokenType_WHILE},
+    [3] = {"read", 4, TokenType_READ},
+    [11] = {"write", 5, TokenType_WRITE},
+};
 
-    _la_insertTokenTypeIntoHash(reservedSymbols, "do", TokenType_DO);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "while", TokenType_WHILE);
+// Symbols and operators, indexed by their first char. The DFA (state 55)
+// only accepts valid ones, so the second char never has to be checked.
+static const unsigned char la_singleCharOperators[128] =
+{
+    ['{'] = TokenType_OPEN_CUR,
+    ['}'] = TokenType_CLOSE_CUR,
+    ['('] = TokenType_OPEN_PAR,
+    [')'] = TokenType_CLOSE_PAR,
+    [';'] = TokenType_SEMICOLON,
+    [','] = TokenType_COLON,
+    ['='] = TokenType_ASSIGN,
+    ['>'] = TokenType_GREATER,
+    ['<'] = TokenType_LOWER,
+    ['!'] = TokenType_NOT,
+    ['+'] = TokenType_ADD,
+    ['-'] = TokenType_SUB,
+    ['*'] = TokenType_MUL,
+    ['/'] = TokenType_DIV,
+};
 
-    _la_insertTokenTypeIntoHash(reservedSymbols, "read", TokenType_READ);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "write", TokenType_WRITE);
+static const unsigned char la_doubleCharOperators[128] =
+{
+    ['>'] = TokenType_GREATER_EQ, // >=
+    ['<'] = TokenType_LOWER_EQ, // <=
+    ['='] = TokenType_EQUALS, // ==
+    ['!'] = TokenType_NOT_EQUALS, // !=
+    ['&'] = TokenType_AND, // &&
+    ['|'] = TokenType_OR, // ||
+};
 
-    _la_insertTokenTypeIntoHash(reservedSymbols, "{", TokenType_OPEN_CUR);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "}", TokenType_CLOSE_CUR);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "(", TokenType_OPEN_PAR);
-    _la_insertTokenTypeIntoHash(reservedSymbols, ")", TokenType_CLOSE_PAR);
-    _la_insertTokenTypeIntoHash(reservedSymbols, ";", TokenType_SEMICOLON);
-    _la_insertTokenTypeIntoHash(reservedSymbols, ",", TokenType_COLON);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "=", TokenType_ASSIGN);
+void _la_checkKeywordTable(void)
+{
+    unsigned count = 0;
+    for (unsigned i = 0; i < LA_KEYWORD_SLOTS; ++i)
+    {
+        const LaKeyword* kw = &la_keywords[i];
+        if (kw->str)
+        {
+            assert(strlen(kw->str) == kw->length);
+            assert(kw->length >= LA_KEYWORD_MIN_LENGTH && kw->length <= LA_KEYWORD_MAX_LENGTH);
+            assert(LA_KEYWORD_HASH(kw->str, kw->length) == i); // keyword stored at its hash slot
+            ++count;
+        }
+    }
+    assert(count == TokenType_FLOAT - TokenType_CLASS + 1); // every keyword is in the table
+    (void) count;
+}
 
-    _la_insertTokenTypeIntoHash(reservedSymbols, ">", TokenType_GREATER);
-    _la_insertTokenTypeIntoHash(reservedSymbols, ">=", TokenType_GREATER_EQ);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "<", TokenType_LOWER);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "<=", TokenType_LOWER_EQ);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "==", TokenType_EQUALS);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "!", TokenType_NOT);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "!=", TokenType_NOT_EQUALS);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "&&", TokenType_AND);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "||", TokenType_OR);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "+", TokenType_ADD);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "-", TokenType_SUB);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "*", TokenType_MUL);
-    _la_insertTokenTypeIntoHash(reservedSymbols, "/", TokenType_DIV);
+// Returns the keyword type of an identifier-shaped lexeme, or TokenType_ID
+TokenType _la_lookupKeyword(const char* str, unsigned length)
+{
+    if (length < LA_KEYWORD_MIN_LENGTH || length > LA_KEYWORD_MAX_LENGTH)
+        return TokenType_ID;
 
-    assert(g_hash_table_size(reservedSymbols) == TokenType_SIZE - 5); // All minus END_OF_FILE, ID, LITERAL, INTEGER and REAL
+    const LaKeyword* kw = &la_keywords[LA_KEYWORD_HASH(str, length)];
+    if (kw->length == length && memcmp(kw->str, str, length) == 0)
+        return kw->type;
+    return TokenType_ID;
 }
 
-LexicalAnalyzer* lexical_analyzer_new(char* filepath)
+// Streaming input: source is a window of sourceSize bytes over fd, refilled by _la_refill
+void _la_initStream(LexicalAnalyzer* self, int fd, int ownsFd)
 {
-    LexicalAnalyzer* la = (LexicalAnalyzer*) malloc(sizeof(LexicalAnalyzer));
-    la->file = fopen(filepath, "r");
+    self->sourceSize = LA_STREAM_WINDOW_SIZE;
+    self->buffer = (char*) malloc(self->sourceSize * sizeof(char));
+    self->source = self->buffer;
+    self->isMapped = 0;
+    self->fd = fd;
+    self->ownsFd = ownsFd;
+    self->sourceOffset = 0;
+    self->cur = self->source;
+    self->end = self->source; // empty until the first refill
+}
 
-    if (!la->file)
+void _la_loadSource(LexicalAnalyzer* self, char* filepath)
+{
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0)
     {
         fprintf(stderr, "Error: cannot open file \"%s\" in read mode. Exiting.\n", filepath);
         exit(-1);
     }
-    la->line = 1;
-    la->column = 1;
-    dstring_init(&la->lex, LA_INITIAL_LEX_CAPACITY);
-    la->reservedSymbols = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, free); // NULL because it's a literal
-    _la_initReservedSymbols(la->reservedSymbols);
-    la->literals = g_hash_table_new_full(g_str_hash, g_str_equal, free, NULL); // NULL because its a set (key = val)
+
+    struct stat st;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        mapped = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    if (mapped != MAP_FAILED)
+    {
+        self->buffer = (char*) mapped;
+        self->source = self->buffer;
+        self->sourceSize = (size_t) st.st_size;
+        self->isMapped = 1;
+        madvise(mapped, self->sourceSize, MADV_SEQUENTIAL);
+        close(fd);
+        DEBUG_PRINT("Mapped %zu bytes from \"%s\".\n", self->sourceSize, filepath);
+
+        self->fd = -1;
+        self->ownsFd = 0;
+        self->sourceOffset = 0;
+        self->cur = self->source;
+        self->end = self->source + self->sourceSize;
+    }
+    else
+    {
+        // Pipes, character devices, empty files...
+        _la_initStream(self, fd, 1);
+        DEBUG_PRINT("Streaming \"%s\".\n", filepath);
+    }
+}
+
+void _la_init(LexicalAnalyzer* self, Interner* interner)
+{
+    dstring_init(&self->lex, LA_INITIAL_LEX_CAPACITY);
+    line_table_init(&self->lines);
+    self->keepsAllLines = 0;
+    _la_checkKeywordTable();
+    self->interner = interner;
+    self->diagnostics = NULL;
+    self->errorTokens = NULL;
+    self->errorQueue = NULL;
+    self->errorMessage[0] = '\0';
+    self->pipeline = NULL;
+}
+
+LexicalAnalyzer* lexical_analyzer_new(char* filepath, Interner* interner)
+{
+    LexicalAnalyzer* la = (LexicalAnalyzer*) malloc(sizeof(LexicalAnalyzer));
+    _la_loadSource(la, filepath);
+    _la_init(la, interner);
     DEBUG_PRINT("Finished constructing Lexical Analyzer.\n");
     return la;
 }
 
+LexicalAnalyzer* lexical_analyzer_newFromFd(int fd, Interner* interner)
+{
+    LexicalAnalyzer* la = (LexicalAnalyzer*) malloc(sizeof(LexicalAnalyzer));
+    _la_initStream(la, fd, 0);
+    _la_init(la, interner);
+    DEBUG_PRINT("Finished constructing Lexical Analyzer over fd %d.\n", fd);
+    return la;
+}
+
 void lexical_analyzer_destroy(LexicalAnalyzer* self)
 {
-    if (self->file)
-        fclose(self->file);
+    if (self->pipeline)
+    {
+        token_queue_close(&self->pipeline->queue);
+        pthread_join(self->pipeline->thread, NULL);
+        token_queue_free(&self->pipeline->queue);
+        dstring_free(&self->pipeline->lexer.lex);
+        free(self->pipeline);
+    }
+    if (self->isMapped)
+        munmap(self->buffer, self->sourceSize);
+    else
+        free(self->buffer);
+    if (self->ownsFd && self->fd >= 0)
+        close(self->fd);
     dstring_free(&self->lex);
-    g_hash_table_destroy(self->reservedSymbols);
-    g_hash_table_destroy(self->literals);
+    line_table_free(&self->lines);
     free(self);
 }
 
-unsigned lexical_analyzer_getLine(const LexicalAnalyzer* self)
+SourcePosition lexical_analyzer_getPosition(LexicalAnalyzer* self, uint32_t offset)
 {
-    return self->line;
+    // Past 4 GiB of streamed input, offsets wrapped: they are taken as inside the window
+    size_t inputOffset = offset;
+    if (self->sourceOffset + (size_t) (self->end - self->source) > UINT32_MAX)
+        inputOffset = self->sourceOffset + (uint32_t) (offset - (uint32_t) self->sourceOffset);
+
+    line_table_index(&self->lines, self->source, self->sourceOffset, inputOffset);
+    return line_table_getPosition(&self->lines, inputOffset);
 }
 
-unsigned lexical_analyzer_getColumn(const LexicalAnalyzer* self)
+// Input offset of a char of the window
+uint32_t _la_offsetOf(const LexicalAnalyzer* self, const char* p)
 {
-    return self->column;
+    return (uint32_t) (self->sourceOffset + (size_t) (p - self->source));
 }
 
-void _la_showExpectedCharErrorAndExit(LexicalAnalyzer* self, char expectedChar, char gotChar)
+// Reports message, found at offset, to the diagnostics, or exits if there are none
+void _la_reportAt(LexicalAnalyzer* self, uint32_t offset, const char* message)
 {
-    fprintf(stderr, "Error at line %d column %d: expected \"%c\", got \"%c\".\n", self->line, self->column, expectedChar, gotChar);
+    SourcePosition position = lexical_analyzer_getPosition(self, offset);
+    if (self->diagnostics)
+    {
+        diagnostics_report(self->diagnostics, position.line, position.column, "%s", message);
+        return;
+    }
+    fprintf(stderr, "Error at line %u column %u: %s", position.line, position.column, message);
     exit(-1);
 }
 
-void _la_showExpectedSequenceErrorAndExit(LexicalAnalyzer* self, char* expectedSequence, char gotChar)
+// Formats the error message, found at the input offset of at. When tokenizing at once, it
+// is stored before the next token, and located when the parser reaches it. On a lexer
+// thread, it is pushed before the next token, and located once popped. Otherwise it is
+// reported right away
+void _la_reportError(LexicalAnalyzer* self, const char* at, const char* format, ...)
 {
-    fprintf(stderr, "Error at line %d column %d: expected \"%s\", got \"%c\".\n", self->line, self->column, expectedSequence, gotChar);
-    exit(-1);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(self->errorMessage, LA_ERROR_MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    if (self->errorTokens)
+    {
+        token_buffer_addError(self->errorTokens, _la_offsetOf(self, at), self->errorMessage);
+    }
+    else if (self->errorQueue)
+    {
+        token_queue_pushError(self->errorQueue, _la_offsetOf(self, at), self->errorMessage);
+    }
+    else
+    {
+        _la_reportAt(self, _la_offsetOf(self, at), self->errorMessage);
+    }
 }
 
-void _la_showMissingSequenceErrorAndExit(LexicalAnalyzer* self, char* missingSequence)
+void _la_showExpectedCharError(LexicalAnalyzer* self, char expectedChar, char gotChar)
 {
-    fprintf(stderr, "Error at line %d column %d: missing \"%s\".\n", self->line, self->column, missingSequence);
-    exit(-1);
+    _la_reportError(self, self->cur, "expected \"%c\", got \"%c\".\n", expectedChar, gotChar);
 }
 
-void _la_showInvalidCharErrorAndExit(LexicalAnalyzer* self, char invalidChar)
+void _la_showExpectedSequenceError(LexicalAnalyzer* self, const char* expectedSequence, char gotChar)
 {
-    fprintf(stderr, "Error at line %d column %d: invalid char \"%c\".\n", self->line, self->column, invalidChar);
-    exit(-1); 
+    _la_reportError(self, self->cur, "expected \"%s\", got \"%c\".\n", expectedSequence, gotChar);
 }
 
-int _la_isFinalState(unsigned state)
+void _la_showMissingSequenceError(LexicalAnalyzer* self, const char* missingSequence)
 {
-    return state == 51 ||
-           state == 52 ||
-           state == 53 ||
-           state == 54;
+    _la_reportError(self, self->cur, "missing \"%s\".\n", missingSequence);
 }
 
-int _la_isLetter(char c)
+void _la_showInvalidCharError(LexicalAnalyzer* self, char invalidChar)
 {
-    return (c >= 'a' && c <= 'z') ||
-           (c >= 'A' && c <= 'Z');
+    _la_reportError(self, self->cur, "invalid char \"%c\".\n", invalidChar);
 }
 
-int _la_isDigit(char c)
+// Copies the lexeme span into self->lex, so it is '\0' terminated
+void _la_setLexeme(LexicalAnalyzer* self, const char* begin, const char* end)
 {
-    return c >= '0' && c <= '9';
+    dstring_clear(&self->lex);
+    dstring_appendN(&self->lex, begin, (unsigned) (end - begin));
 }
 
-int _la_isNonZeroDigit(char c)
+void _la_showOutOfRangeError(LexicalAnalyzer* self, const char* kind, const char* begin, const char* end)
 {
-  return c >= '1' && c <= '9';
+    int length = end - begin > LA_MAX_SHOWN_CONSTANT ? LA_MAX_SHOWN_CONSTANT : (int) (end - begin);
+    _la_reportError(self, begin, "%s constant \"%.*s\" out of range.\n", kind, length, begin);
 }
 
-Token lexical_analyzer_getToken(LexicalAnalyzer* self)
+void _la_showDfaError(LexicalAnalyzer* self, const LaDfaErrorAction* error, char gotChar)
 {
-    int i;
-    char c;
-    unsigned state = 0;
+    switch (error->action)
+    {
+    case LaDfaAction_INVALID_CHAR:
+        _la_showInvalidCharError(self, gotChar);
+        break;
+    case LaDfaAction_EXPECTED_CHAR:
+        _la_showExpectedCharError(self, error->arg[0], gotChar);
+        break;
+    case LaDfaAction_EXPECTED_SEQUENCE:
+        _la_showExpectedSequenceError(self, error->arg, gotChar);
+        break;
+    case LaDfaAction_MISSING_SEQUENCE:
+        _la_showMissingSequenceError(self, error->arg);
+        break;
+    case LaDfaAction_NONE:
+    default:
+        assert("DFA error action not handled." && 0);
+        break;
+    }
+}
 
-    while (!_la_isFinalState(state))
+// Value of an integer lexeme, already validated by the DFA ([1-9][0-9]* or 0).
+// Returns 0 if it does not fit in a long
+int _la_convertInteger(const char* begin, const char* end, long* value)
+{
+    long v = 0;
+    for (; begin != end; ++begin)
     {
-        i = fgetc(self->file);
+        long digit = *begin - '0';
+        if (v > (LONG_MAX - digit) / 10)
+            return 0;
+        v = v * 10 + digit;
+    }
+    *value = v;
+    return 1;
+}
 
-        if (i == EOF)
+// Powers of ten that are exact doubles
+static const double la_exactPowersOf10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+#define LA_MAX_EXACT_POWER_OF_10 22
+#define LA_MAX_EXACT_MANTISSA (1ull << 53)
+
+// Value of a real lexeme, already validated by the DFA ([0-9]+ "." [0-9]+), rounded like strtod.
+// Clinger's fast path: if the digits (without the '.') fit in 53 bits and there are at most
+// 22 decimals, both are exact doubles and one division rounds correctly. Otherwise strtod.
+double _la_convertReal(LexicalAnalyzer* self, const char* begin, const char* end)
+{
+#if FLT_EVAL_METHOD == 0
+    uint64_t mantissa = 0;
+    int decimals = -1; // digits after the '.'
+    const char* p = begin;
+    for (; p != end && mantissa <= LA_MAX_EXACT_MANTISSA; ++p)
+    {
+        if (*p == '.')
+            decimals = 0;
+        else
         {
-            break;
+            mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+            if (decimals >= 0)
+                ++decimals;
         }
+    }
 
-        c = (char) i;
-        switch (state) {
-        case 0:
-            if (c == '\n')
-            {
-                ++self->line;
-                self->column = 0;
-                state = 0;
-            }
-            else if (c == '\t' ||
-                     c == '\r' ||
-                     c == ' ')
-            {
-                state = 0;
-            }
-            else if (c == '<' ||
-                     c == '>' ||
-                     c == '=' ||
-                     c == '!')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 1;
-            }
-            else if (c == '|')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 2;
-            }
-            else if (c == '&')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 3;
-            }
-            else if (_la_isLetter(c))
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 4;
-            }
-            else if (c == '{' ||
-                     c == '}' ||
-                     c == '(' ||
-                     c == ')' ||
-                     c == ';' ||
-                     c == ',' ||
-                     c == '+' ||
-                     c == '-' ||
-                     c == '*')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 53;
-            }
-            else if (c == '/')
-            {
-                dstring_appendChar(&self->lex, c); // this has to be removed later if it's a comment
-                state = 5;
-            }
-            else if (c == '\"')
-            {
-                state = 6;
-            }
-            else if (_la_isNonZeroDigit(c))
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 7;
-            }
-            else if (c == '0')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 8;
-            }
-            else
-            {
-                _la_showInvalidCharErrorAndExit(self, c); // invalid starting character
-            }
-            break;
-        case 1:
-            if (c == '=')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 53;
-            }
-            else
-            {
-                ungetc(c, self->file);
-                state = 53;
-            }
-            break;
-        case 2:
-            if (c == '|')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 53;
-            }
-            else
-            {
-                // invalid character different from | after |
-                _la_showExpectedCharErrorAndExit(self, '|', c);
-            }
-            break;
-        case 3:
-            if (c == '&')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 53;
-            }
-            else
-            {
-                // invalid character different from & after &
-                _la_showExpectedCharErrorAndExit(self, '&', c);
-            }
-            break;
-        case 4:
-            if (_la_isLetter(c) ||
-                _la_isDigit(c) ||
-                c == '_')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 4;
-            }
-            else
-            {
-                ungetc(c, self->file);
-                state = 53;
-            }
-            break;
-        case 5:
-            if (c == '/')
-            {
-                dstring_clear(&self->lex); // remove previously added '/' into lex
-                state = 11;
-            }
-            else if (c == '*')
-            {
-                dstring_clear(&self->lex); // remove previously added '/' into lex
-                state = 12;
-            }
-            else
-            {
-                ungetc(c, self->file);
-                state = 53;
-            }
-            break;
-        case 6:
-            if (c == '\"')
-            {
-                state = 54;
-            }
-            else if (c == '\n')
-            {
-                // invalid character "\n" inside literal quotes
-                _la_showMissingSequenceErrorAndExit(self, "\"");
-            }
-            else
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 6;
-            }
-            break;
-        case 7:
-            if (_la_isDigit(c))
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 7;
-            }
-            else if (c == '.')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 9;
-            }
-            else
-            {
-                ungetc(c, self->file);
-                state = 51;
-            }
-            break;
-        case 8:
-            if (c == '.')
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 9;
-            }
-            else
-            {
-                // NOTE: 0 will always retorn a token 0
-                // If there is a sequence of 010, it will output TokenInteger(0), TokenInteger(10)
-                ungetc(c, self->file);
-                state = 51;
-            }
-            break;
-        case 9:
-            if (_la_isDigit(c))
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 10;
-            }
-            else
-            {
-                // invalid char different from digit after (digit)+'.'
-                _la_showExpectedSequenceErrorAndExit(self, "digit", c);
-            }
-            break;
-        case 10:
-            if (_la_isDigit(c))
-            {
-                dstring_appendChar(&self->lex, c);
-                state = 10;
-            }
-            else
-            {
-                ungetc(c, self->file);
-                state = 52;
-            }
-            break;
-        case 11:
-            if (c == '\n')
-            {
-                ++self->line;
-                self->column = 0;
-                state = 0;
-            }
-            else
-            {
-                state = 11;
-            }
-            break;
-        case 12:
-            if (c == '*')
-            {
-                state = 13;
-            }
-            else if (c == '\n')
-            {
-                ++self->line;
-                self->column = 0;
-                state = 12;
-            }
-            else
-            {
-                state = 12;
-            }
-            break;
-        case 13:
-            if (c == '/')
-            {
-                state = 0;
-            }
-            else if (c == '*')
-            {
-                state = 13;
-            }
-            else if (c == '\n')
-            {
-                ++self->line;
-                self->column = 0;
-                state = 12;
+    if (p == end && mantissa <= LA_MAX_EXACT_MANTISSA && decimals <= LA_MAX_EXACT_POWER_OF_10)
+        return (double) mantissa / la_exactPowersOf10[decimals];
+#endif
+
+    char* endptr;
+    _la_setLexeme(self, begin, end);
+    double value = strtod(self->lex.str, &endptr);
+    assert(self->lex.str + self->lex.length == endptr); // lex contains only convertible chars
+    (void) endptr;
+    dstring_clear(&self->lex);
+    return value;
+}
+
+// States whose self loops are skipped in bulk by _la_skipRun
+static const unsigned char la_hasRun[LA_DFA_STATE_COUNT] =
+{
+    [LA_DFA_STATE_0] = 1, // blanks
+    [LA_DFA_STATE_4] = 1, // identifier chars
+    [LA_DFA_STATE_6] = 1, // literal chars
+    [LA_DFA_STATE_11] = 1, // '//' comment body
+    [LA_DFA_STATE_12] = 1, // '/* */' comment body
+};
+
+// Consumes the longest run of chars that keeps the DFA in the same state.
+// The char that ends the run is left for the transition table.
+void _la_skipRun(LexicalAnalyzer* self, unsigned char state)
+{
+    const char* runEnd;
+
+    switch (state)
+    {
+    case LA_DFA_STATE_0:
+        runEnd = char_scan_skipBlanks(self->cur, self->end);
+        break;
+    case LA_DFA_STATE_4:
+        runEnd = char_scan_skipIdentifierChars(self->cur, self->end);
+        break;
+    case LA_DFA_STATE_6:
+        runEnd = char_scan_findLiteralEnd(self->cur, self->end);
+        break;
+    case LA_DFA_STATE_11:
+        runEnd = char_scan_findNewline(self->cur, self->end);
+        break;
+    case LA_DFA_STATE_12:
+        runEnd = char_scan_findStar(self->cur, self->end);
+        break;
+    default:
+        assert("State without run kernel." && 0);
+        return;
+    }
+
+    self->cur = runEnd;
+}
+
+// States whose chars never belong to a lexeme: blanks and comments
+static const unsigned char la_dropsLexeme[LA_DFA_STATE_COUNT] =
+{
+    [LA_DFA_STATE_0] = 1,
+    [LA_DFA_STATE_11] = 1,
+    [LA_DFA_STATE_12] = 1,
+    [LA_DFA_STATE_13] = 1,
+};
+
+// Streamed input, called when the window is exhausted: reads the next block. The part of the
+// current lexeme already read is moved to the start of the window first, so lexemes stay
+// contiguous. The window only grows if a single lexeme fills it. Returns the new lexBegin.
+const char* _la_refill(LexicalAnalyzer* self, unsigned char state, const char* lexBegin)
+{
+    const char* keep = la_dropsLexeme[state] ? self->cur : lexBegin;
+    size_t kept = (size_t) (self->end - keep);
+
+    // The dropped text can not be scanned for lines later
+    size_t keepOffset = self->sourceOffset + (size_t) (keep - self->source);
+    line_table_index(&self->lines, self->source, self->sourceOffset, keepOffset);
+    if (!self->keepsAllLines)
+        line_table_discardBefore(&self->lines, keepOffset);
+    self->sourceOffset = keepOffset;
+    memmove(self->buffer, keep, kept);
+    if (kept == self->sourceSize)
+    {
+        self->sourceSize *= 2;
+        self->buffer = (char*) realloc(self->buffer, self->sourceSize * sizeof(char));
+    }
+    self->source = self->buffer;
+
+    ssize_t nread;
+    do
+    {
+        nread = read(self->fd, self->buffer + kept, self->sourceSize - kept);
+    } while (nread < 0 && errno == EINTR);
+
+    if (nread < 0)
+    {
+        fprintf(stderr, "Error: cannot read the input. Exiting.\n");
+        exit(-1);
+    }
+    else if (nread == 0)
+    {
+        if (self->ownsFd)
+            close(self->fd);
+        self->fd = -1;
+    }
+
+    self->cur = self->source + kept;
+    self->end = self->cur + nread;
+    return self->source;
+}
+
+// Reads the next token. Once an error is reported, the partial lexeme is dropped and
+// scanning starts over at the offending char, and out of range constants are read as 0
+Token _la_scanToken(LexicalAnalyzer* self)
+{
+    const char* lexBegin = self->cur;
+    unsigned char state = LA_DFA_STATE_0;
+    unsigned char entry;
+    unsigned runLength = 0; // consecutive self loop transitions
+    char c;
+
+    while (!la_dfa_isFinal[state])
+    {
+        if (self->cur == self->end)
+        {
+            if (self->fd >= 0)
+            {
+                lexBegin = _la_refill(self, state, lexBegin);
+            }
+            if (self->cur == self->end)
+            {
+                entry = la_dfa_next[state][LA_DFA_EOF_CLASS];
+                if (entry == LA_DFA_END || entry == LA_DFA_ERROR)
+                {
+                    if (entry == LA_DFA_ERROR)
+                    {
+                        _la_showDfaError(self, &la_dfa_onEof[state], '\0');
+                    }
+                    Token t;
+                    t.type = TokenType_END_OF_FILE;
+                    t.offset = _la_offsetOf(self, self->cur);
+                    return t;
+                }
+                state = entry & LA_DFA_STATE_MASK; // lookahead into a final state
+                break;
             }
-            else
+        }
+
+        c = *self->cur;
+        entry = la_dfa_next[state][la_dfa_charClass[(unsigned char) c]];
+        if (entry == LA_DFA_ERROR)
+        {
+            _la_showDfaError(self, &la_dfa_onError[state], c);
+            // A char that cannot start a token is skipped
+            if (state == LA_DFA_STATE_0)
+                ++self->cur;
+            state = LA_DFA_STATE_0;
+            runLength = 0;
+            lexBegin = self->cur;
+            continue;
+        }
+
+        if (state == LA_DFA_STATE_0)
+        {
+            lexBegin = self->cur; // skipped blanks and comments are not part of the lexeme
+        }
+
+        // lookahead transitions leave the cursor on the current char
+        if (!(entry & LA_DFA_LOOKAHEAD))
+        {
+            ++self->cur;
+        }
+
+        // Short runs are cheaper through the table, long ones are handed to the scan kernels
+        if (entry == state)
+        {
+            if (++runLength == LA_RUN_THRESHOLD && la_hasRun[state])
             {
-                state = 12;
+                _la_skipRun(self, state);
             }
-            break;
-        default:
-            assert("Invalid state value in getToken loop." && 0);
-            break;
         }
-        ++self->column;
-    }
-
-    if (!_la_isFinalState(state) && state != 0)
-    {
-        // unexpected EOF
-        switch (state)
+        else
         {
-        case 2:
-            // unexpected EOF after |
-            _la_showMissingSequenceErrorAndExit(self, "|");
-            break;
-        case 3:
-            // unexpected EOF after &
-            _la_showMissingSequenceErrorAndExit(self, "&");
-            break;
-        case 6:
-            // unexpected EOF after literal quote start
-            _la_showMissingSequenceErrorAndExit(self, "\"");
-            break;
-        case 12:
-            // comment /* not finished
-            _la_showMissingSequenceErrorAndExit(self, "*/");
-            break;
-        case 13:
-            // comment /* not finished, but last char was *
-            _la_showMissingSequenceErrorAndExit(self, "/");
-            break;
-        default:
-            assert("Unexpected EOF error state not handled." && 0);
-            break;
+            runLength = 0;
         }
+        state = entry & LA_DFA_STATE_MASK;
     }
 
     Token t;
-    char* endptr;
-    void* curKey;
-    void* curValue;
+    t.offset = _la_offsetOf(self, lexBegin);
 
     switch (state)
     {
-    case 0:
-        t.type = TokenType_END_OF_FILE;
-        break;
-    case 51:
+    case LA_DFA_STATE_51:
         t.type = TokenType_INTEGER;
-        t.longVal = strtol(self->lex.str, &endptr, 10);
-        assert(self->lex.str + self->lex.length == endptr); // lex contains only convertible chars
-        dstring_clear(&self->lex);
+        if (!_la_convertInteger(lexBegin, self->cur, &t.longVal))
+        {
+            _la_showOutOfRangeError(self, "integer", lexBegin, self->cur);
+            t.longVal = 0;
+        }
         break;
-    case 52:
+    case LA_DFA_STATE_52:
         t.type = TokenType_REAL;
-        t.doubleVal = strtod(self->lex.str, &endptr);
-        assert(self->lex.str + self->lex.length == endptr); // lex contains only convertible chars
-        dstring_clear(&self->lex);
-        break;
-    case 53:
-        curValue = g_hash_table_lookup(self->reservedSymbols, self->lex.str);
-        if (curValue == NULL) // is an identifier
+        t.doubleVal = _la_convertReal(self, lexBegin, self->cur);
+        if (t.doubleVal > DBL_MAX)
         {
-            t.type = TokenType_ID;
-            dstring_shrinkToFit(&self->lex);
-            t.lex = dstring_steal(&self->lex, LA_INITIAL_LEX_CAPACITY);
+            _la_showOutOfRangeError(self, "real", lexBegin, self->cur);
+            t.doubleVal = 0.0;
         }
-        else // it is a reserved word or symbol
+        break;
+    case LA_DFA_STATE_53:
+        t.type = _la_lookupKeyword(lexBegin, (unsigned) (self->cur - lexBegin));
+        if (t.type == TokenType_ID)
         {
-            t.type = *((const TokenType*) curValue);
+            // Lexer threads have no interner: they keep the length, and the id is set when popped
+            if (self->interner)
+                t.symbolId = interner_intern(self->interner, lexBegin, (unsigned) (self->cur - lexBegin));
+            else
+                t.symbolId = (uint32_t) (self->cur - lexBegin);
         }
-        dstring_clear(&self->lex);
         break;
-    case 54:
+    case LA_DFA_STATE_55:
+        if (self->cur - lexBegin == 1)
+            t.type = la_singleCharOperators[(unsigned char) lexBegin[0]];
+        else
+            t.type = la_doubleCharOperators[(unsigned char) lexBegin[0]];
+        break;
+    case LA_DFA_STATE_54:
         t.type = TokenType_LITERAL;
-        if (g_hash_table_lookup_extended(self->literals, self->lex.str, &curKey, &curValue))
-        {
-            assert(curKey == curValue); // NOTE: key == value because we are using as a set
-            // entry already exists. clear lex and assign token literal to existing one
-            DEBUG_PRINT("Literal \"%s\" already exists in table."
-                " Assigning to already existing key ptr %p.\n", self->lex.str, curKey);
-            t.literal = (char*) curKey;
-            dstring_clear(&self->lex);
-        }
+        // without the quotes. Equal literals share the same string
+        if (self->interner)
+            t.literalId = interner_intern(self->interner, lexBegin + 1, (unsigned) (self->cur - lexBegin - 2));
         else
-        {
-            dstring_shrinkToFit(&self->lex);
-            g_hash_table_add(self->literals, self->lex.str);
-            DEBUG_PRINT("New literal \"%s\" inserted into literal table. Key ptr is %p.\n", self->lex.str, self->lex.str);
-            t.literal = dstring_steal(&self->lex, LA_INITIAL_LEX_CAPACITY);
-        }
+            t.literalId = (uint32_t) (self->cur - lexBegin - 2);
         break;
     default:
         assert("Invalid final state reached." && 0);
@@ -546,3 +677,213 @@ Token lexical_analyzer_getToken(LexicalAnalyzer* self)
 
     return t;
 }
+
+void lexical_analyzer_setDiagnostics(LexicalAnalyzer* self, Diagnostics* diagnostics)
+{
+    self->diagnostics = diagnostics;
+}
+
+void* _la_produceTokens(void* arg)
+{
+    LaPipeline* pipeline = (LaPipeline*) arg;
+    Token t;
+    do
+    {
+        t = _la_scanToken(&pipeline->lexer);
+        if (!token_queue_push(&pipeline->queue, &t))
+            break;
+    } while (t.type != TokenType_END_OF_FILE);
+    token_queue_flush(&pipeline->queue);
+    return NULL;
+}
+
+// Next token of the lexer thread. Errors before it are reported first, as on demand
+// lexing does, and identifiers and literals are interned in source order
+Token _la_popToken(LexicalAnalyzer* self)
+{
+    LaPipeline* pipeline = self->pipeline;
+    if (pipeline->reachedEnd)
+        return pipeline->end;
+
+    TokenQueueEntry entry = token_queue_pop(&pipeline->queue);
+    while (entry.errorMessage)
+    {
+        _la_reportAt(self, entry.token.offset, entry.errorMessage);
+        free(entry.errorMessage);
+        entry = token_queue_pop(&pipeline->queue);
+    }
+
+    Token t = entry.token;
+    const char* lexBegin = self->source + t.offset;
+    if (t.type == TokenType_ID)
+    {
+        t.symbolId = interner_intern(self->interner, lexBegin, t.symbolId);
+    }
+    else if (t.type == TokenType_LITERAL)
+    {
+        t.literalId = interner_intern(self->interner, lexBegin + 1, t.literalId);
+    }
+    else if (t.type == TokenType_END_OF_FILE)
+    {
+        pipeline->reachedEnd = 1;
+        pipeline->end = t;
+    }
+    return t;
+}
+
+Token lexical_analyzer_getToken(LexicalAnalyzer* self)
+{
+    if (self->pipeline)
+        return _la_popToken(self);
+    return _la_scanToken(self);
+}
+
+void lexical_analyzer_tokenizeAll(LexicalAnalyzer* self, TokenBuffer* tokens)
+{
+    if (self->sourceSize > UINT32_MAX)
+    {
+        fprintf(stderr, "Error: source file is too large to be tokenized at once. Exiting.\n");
+        exit(-1);
+    }
+
+    token_buffer_init(tokens, self->sourceSize / LA_BYTES_PER_TOKEN_ESTIMATE + 1);
+    self->keepsAllLines = 1; // any token may be located later
+    self->errorTokens = tokens;
+    Token t;
+    do
+    {
+        t = _la_scanToken(self);
+        token_buffer_push(tokens, &t);
+    } while (t.type != TokenType_END_OF_FILE);
+    self->errorTokens = NULL;
+}
+
+// Lexer over [begin, end) of a borrowed source, starting between tokens.
+// Token offsets are relative to source. Only self->lex has to be freed
+void _la_initRangeLexer(LexicalAnalyzer* self, const char* source, size_t sourceSize, const char* begin, const char* end, Interner* interner)
+{
+    dstring_init(&self->lex, LA_INITIAL_LEX_CAPACITY);
+    self->source = source;
+    self->buffer = NULL;
+    self->sourceSize = sourceSize;
+    self->isMapped = 0;
+    self->fd = -1;
+    self->ownsFd = 0;
+    self->sourceOffset = 0;
+    self->cur = begin;
+    self->end = end;
+    self->interner = interner;
+    self->diagnostics = NULL;
+    self->errorTokens = NULL;
+    self->errorQueue = NULL;
+    self->errorMessage[0] = '\0';
+    self->pipeline = NULL;
+}
+
+void lexical_analyzer_startThread(LexicalAnalyzer* self)
+{
+    // Token offsets are 32 bits, and streamed text does not stay in memory
+    if (self->fd >= 0 || self->sourceSize > UINT32_MAX || self->pipeline)
+        return;
+
+    LaPipeline* pipeline = (LaPipeline*) malloc(sizeof(LaPipeline));
+    _la_initRangeLexer(&pipeline->lexer, self->source, self->sourceSize, self->cur, self->end, NULL);
+    pipeline->lexer.errorQueue = &pipeline->queue;
+    token_queue_init(&pipeline->queue);
+    pipeline->reachedEnd = 0;
+    if (pthread_create(&pipeline->thread, NULL, _la_produceTokens, pipeline) != 0)
+    {
+        fprintf(stderr, "Error: cannot create lexer thread. Exiting.\n");
+        exit(-1);
+    }
+    self->pipeline = pipeline;
+    self->cur = self->end; // the thread lexes the rest
+}
+
+// Token where lexing restarts after an edit at offset: the last one starting before it.
+// The text up to its first char did not change, and the lexer is always between tokens
+// there, so it is lexed the same. Returns tokens->size if there is none
+size_t _la_findRestartToken(const TokenBuffer* tokens, size_t offset)
+{
+    // Binary search of the first token starting at or after offset
+    size_t lo = 0, hi = tokens->size;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (tokens->offsets[mid] < offset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo > 0 ? lo - 1 : tokens->size;
+}
+
+TokenRange lexical_analyzer_relex(TokenBuffer* tokens, const char* source, size_t sourceSize, const SourceEdit* edit, Interner* interner)
+{
+    if (sourceSize > UINT32_MAX)
+    {
+        fprintf(stderr, "Error: source file is too large to be tokenized at once. Exiting.\n");
+        exit(-1);
+    }
+
+    size_t first = _la_findRestartToken(tokens, edit->offset);
+    const char* restart = source;
+    if (first == tokens->size)
+        first = 0;
+    else
+        restart = source + tokens->offsets[first];
+
+    LexicalAnalyzer lexer;
+    _la_initRangeLexer(&lexer, source, sourceSize, restart, source + sourceSize, interner);
+    TokenBuffer fresh;
+    token_buffer_init(&fresh, LA_RELEX_INITIAL_CAPACITY);
+    lexer.errorTokens = &fresh;
+
+    // Old tokens after the edit are compared in new offsets: old offset + delta
+    long delta = (long) edit->insertedLength - (long) edit->removedLength;
+    size_t editEnd = edit->offset + edit->insertedLength;
+    size_t old = first;
+    size_t sync = tokens->size; // first old token reused, if the streams line up again
+
+    for (;;)
+    {
+        Token t = _la_scanToken(&lexer);
+
+        // A token starting where an old one started, past the edit: the rest of the text is
+        // the same and the lexer is between tokens, so the rest of the tokens are too
+        if (t.type != TokenType_END_OF_FILE && t.offset >= editEnd)
+        {
+            while (old < tokens->size && (long) tokens->offsets[old] + delta < (long) t.offset)
+                ++old;
+            if (old < tokens->size && (long) tokens->offsets[old] + delta == (long) t.offset && tokens->types[old] == t.type)
+            {
+                sync = old;
+                break;
+            }
+        }
+
+        token_buffer_push(&fresh, &t);
+        if (t.type == TokenType_END_OF_FILE)
+            break;
+    }
+    dstring_free(&lexer.lex);
+
+    TokenRange changed;
+    changed.first = first;
+    changed.oldCount = sync - first;
+    changed.newCount = fresh.size;
+
+    token_buffer_replace(tokens, first, changed.oldCount, &fresh);
+    for (size_t i = first + fresh.size; i < tokens->size; ++i)
+    {
+        tokens->offsets[i] = (uint32_t) ((long) tokens->offsets[i] + delta);
+    }
+    for (size_t i = 0; i < tokens->errorCount; ++i)
+    {
+        // Errors found before the first reused token are new
+        if (tokens->errors[i].index > first + fresh.size)
+            tokens->errors[i].offset = (uint32_t) ((long) tokens->errors[i].offset + delta);
+    }
+    token_buffer_free(&fresh);
+    return changed;
+}
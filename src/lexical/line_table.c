@@ -0,0 +1,96 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "lexical/line_table.h"
+
+#include "lexical/char_scan.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LT_INITIAL_CAPACITY 64
+
+void line_table_init(LineTable* self)
+{
+    self->capacity = LT_INITIAL_CAPACITY;
+    self->starts = (size_t*) malloc(self->capacity * sizeof(size_t));
+    self->starts[0] = 0;
+    self->count = 1;
+    self->firstLine = 1;
+    self->indexedEnd = 0;
+}
+
+void line_table_free(LineTable* self)
+{
+    free(self->starts);
+    self->starts = NULL;
+    self->count = 0;
+    self->capacity = 0;
+}
+
+void _lt_push(LineTable* self, size_t start)
+{
+    if (self->count == self->capacity)
+    {
+        self->capacity *= 2;
+        self->starts = (size_t*) realloc(self->starts, self->capacity * sizeof(size_t));
+    }
+    self->starts[self->count++] = start;
+}
+
+void line_table_index(LineTable* self, const char* text, size_t textOffset, size_t end)
+{
+    assert(textOffset <= self->indexedEnd);
+    if (end <= self->indexedEnd)
+        return;
+
+    const char* cur = text + (self->indexedEnd - textOffset);
+    const char* stop = text + (end - textOffset);
+    while ((cur = char_scan_findNewline(cur, stop)) != stop)
+    {
+        ++cur; // the line starts after its '\n'
+        _lt_push(self, textOffset + (size_t) (cur - text));
+    }
+    self->indexedEnd = end;
+}
+
+// Index of the line of offset in starts
+size_t _lt_findLine(const LineTable* self, size_t offset)
+{
+    assert(offset <= self->indexedEnd && offset >= self->starts[0]);
+    size_t lo = 0, hi = self->count; // last start <= offset is in [lo, hi)
+    while (hi - lo > 1)
+    {
+        size_t mid = lo + (hi - lo) / 2;
+        if (self->starts[mid] <= offset)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+void line_table_discardBefore(LineTable* self, size_t offset)
+{
+    size_t line = _lt_findLine(self, offset);
+    memmove(self->starts, self->starts + line, (self->count - line) * sizeof(size_t));
+    self->count -= line;
+    self->firstLine += (unsigned) line;
+}
+
+SourcePosition line_table_getPosition(const LineTable* self, size_t offset)
+{
+    size_t line = _lt_findLine(self, offset);
+    SourcePosition position;
+    position.line = self->firstLine + (unsigned) line;
+    position.column = (unsigned) (offset - self->starts[line]) + 1;
+    return position;
+}
@@ -10,6 +10,7 @@
 
 #include "lexical/token.h"
 #include "symbol_table/symbol_table.h"
+#include "util/interner.h"
 
 #include <assert.h>
 #include <stdio.h>
@@ -253,20 +254,22 @@ const char* token_type_toUserString(TokenType tt)
     return str;
 }
 
-char* token_lexemeToString(const Token* t)
+char* token_lexemeToString(const Token* t, const Interner* interner)
 {   
     char* str = NULL;
 
     // create copy so the token will not be modified
     if (t->type == TokenType_ID)
     {
-        str = (char*) malloc((strlen(t->lex) + 1) * sizeof(char));
-        strcpy(str, t->lex);
+        const char* lex = interner_getString(interner, t->symbolId);
+        str = (char*) malloc((strlen(lex) + 1) * sizeof(char));
+        strcpy(str, lex);
     }
     else if (t->type == TokenType_LITERAL)
     {
-        str = (char*) malloc((strlen(t->literal) + 1) * sizeof(char));
-        strcpy(str, t->literal);
+        const char* lex = interner_getString(interner, t->literalId);
+        str = (char*) malloc((strlen(lex) + 1) * sizeof(char));
+        strcpy(str, lex);
     }
     else if (t->type == TokenType_INTEGER)
     {
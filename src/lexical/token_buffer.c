@@ -0,0 +1,203 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "lexical/token_buffer.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+void _tb_reserve(TokenBuffer* self, size_t capacity)
+{
+    self->types = (uint8_t*) realloc(self->types, capacity * sizeof(uint8_t));
+    self->payloads = (TokenPayload*) realloc(self->payloads, capacity * sizeof(TokenPayload));
+    self->offsets = (uint32_t*) realloc(self->offsets, capacity * sizeof(uint32_t));
+    self->capacity = capacity;
+}
+
+void token_buffer_init(TokenBuffer* self, size_t initialCapacity)
+{
+    self->types = NULL;
+    self->payloads = NULL;
+    self->offsets = NULL;
+    self->size = 0;
+    self->errors = NULL;
+    self->errorCount = 0;
+    self->errorCapacity = 0;
+    _tb_reserve(self, initialCapacity > 0 ? initialCapacity : 1);
+}
+
+void token_buffer_free(TokenBuffer* self)
+{
+    free(self->types);
+    free(self->payloads);
+    free(self->offsets);
+    for (size_t i = 0; i < self->errorCount; ++i)
+        free(self->errors[i].message);
+    free(self->errors);
+    self->types = NULL;
+    self->payloads = NULL;
+    self->offsets = NULL;
+    self->errors = NULL;
+    self->size = 0;
+    self->capacity = 0;
+    self->errorCount = 0;
+    self->errorCapacity = 0;
+}
+
+char* _tb_copyMessage(const char* message)
+{
+    size_t length = strlen(message);
+    char* copy = (char*) malloc((length + 1) * sizeof(char));
+    memcpy(copy, message, length + 1);
+    return copy;
+}
+
+// Appends an error, copying its message
+void _tb_pushError(TokenBuffer* self, size_t index, uint32_t offset, const char* message)
+{
+    if (self->errorCount == self->errorCapacity)
+    {
+        self->errorCapacity = self->errorCapacity > 0 ? self->errorCapacity * 2 : 4;
+        self->errors = (TokenBufferError*) realloc(self->errors, self->errorCapacity * sizeof(TokenBufferError));
+    }
+
+    TokenBufferError* error = &self->errors[self->errorCount++];
+    error->index = index;
+    error->offset = offset;
+    error->message = _tb_copyMessage(message);
+}
+
+void token_buffer_push(TokenBuffer* self, const Token* t)
+{
+    if (self->size == self->capacity)
+    {
+        _tb_reserve(self, self->capacity * 2);
+    }
+
+    size_t i = self->size++;
+    self->types[i] = (uint8_t) t->type;
+    switch (t->type)
+    {
+    case TokenType_INTEGER:
+        self->payloads[i].longVal = t->longVal;
+        break;
+    case TokenType_REAL:
+        self->payloads[i].doubleVal = t->doubleVal;
+        break;
+    case TokenType_ID:
+        self->payloads[i].symbolId = t->symbolId;
+        break;
+    case TokenType_LITERAL:
+        self->payloads[i].literalId = t->literalId;
+        break;
+    default:
+        self->payloads[i].longVal = 0;
+        break;
+    }
+    self->offsets[i] = t->offset;
+}
+
+void token_buffer_addError(TokenBuffer* self, uint32_t offset, const char* message)
+{
+    _tb_pushError(self, self->size, offset, message);
+}
+
+void token_buffer_removeLastError(TokenBuffer* self)
+{
+    assert(self->errorCount > 0);
+    free(self->errors[--self->errorCount].message);
+}
+
+void token_buffer_replace(TokenBuffer* self, size_t first, size_t count, const TokenBuffer* replacement)
+{
+    assert(first + count <= self->size);
+    uint32_t firstOffset = first < self->size ? self->offsets[first] : UINT32_MAX;
+    size_t size = self->size - count + replacement->size;
+    if (size > self->capacity)
+    {
+        size_t capacity = self->capacity * 2;
+        if (capacity < size)
+            capacity = size;
+        _tb_reserve(self, capacity);
+    }
+
+    // Moves the tail, then copies the replacement in the gap
+    size_t tail = self->size - first - count;
+    size_t from = first + count;
+    size_t to = first + replacement->size;
+    memmove(self->types + to, self->types + from, tail * sizeof(uint8_t));
+    memmove(self->payloads + to, self->payloads + from, tail * sizeof(TokenPayload));
+    memmove(self->offsets + to, self->offsets + from, tail * sizeof(uint32_t));
+    memcpy(self->types + first, replacement->types, replacement->size * sizeof(uint8_t));
+    memcpy(self->payloads + first, replacement->payloads, replacement->size * sizeof(TokenPayload));
+    memcpy(self->offsets + first, replacement->offsets, replacement->size * sizeof(uint32_t));
+    self->size = size;
+
+    // Errors found before the first replaced token are kept, the ones after the token
+    // following them are moved
+    size_t keep = 0;
+    while (keep < self->errorCount && (self->errors[keep].index < first || (self->errors[keep].index == first && self->errors[keep].offset < firstOffset)))
+        ++keep;
+    size_t after = keep;
+    while (after < self->errorCount && self->errors[after].index <= first + count)
+        free(self->errors[after++].message);
+    size_t errorCount = keep + replacement->errorCount + self->errorCount - after;
+    TokenBufferError* errors = (TokenBufferError*) malloc((errorCount + 1) * sizeof(TokenBufferError));
+    memcpy(errors, self->errors, keep * sizeof(TokenBufferError));
+    TokenBufferError* error = errors + keep;
+    for (size_t i = 0; i < replacement->errorCount; ++i, ++error)
+    {
+        error->index = first + replacement->errors[i].index;
+        error->offset = replacement->errors[i].offset;
+        error->message = _tb_copyMessage(replacement->errors[i].message);
+    }
+    for (size_t i = after; i < self->errorCount; ++i, ++error)
+    {
+        *error = self->errors[i];
+        error->index = error->index - count + replacement->size;
+    }
+    free(self->errors);
+    self->errors = errors;
+    self->errorCount = errorCount;
+    self->errorCapacity = errorCount;
+}
+
+Token token_buffer_get(const TokenBuffer* self, size_t index)
+{
+    assert(index < self->size);
+    Token t;
+    t.type = (TokenType) self->types[index];
+    t.offset = self->offsets[index];
+    switch (t.type)
+    {
+    case TokenType_INTEGER:
+        t.longVal = self->payloads[index].longVal;
+        break;
+    case TokenType_REAL:
+        t.doubleVal = self->payloads[index].doubleVal;
+        break;
+    case TokenType_ID:
+        t.symbolId = self->payloads[index].symbolId;
+        break;
+    case TokenType_LITERAL:
+        t.literalId = self->payloads[index].literalId;
+        break;
+    default:
+        break;
+    }
+    return t;
+}
+
+TokenType token_buffer_getType(const TokenBuffer* self, size_t index)
+{
+    assert(index < self->size);
+    return (TokenType) self->types[index];
+}
@@ -0,0 +1,123 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "lexical/token_queue.h"
+
+#include <sched.h> // sched_yield
+#include <stdlib.h>
+#include <string.h>
+
+#define TQ_MASK (TOKEN_QUEUE_CAPACITY - 1)
+#define TQ_SPINS 128 // checks before yielding the processor
+
+void token_queue_init(TokenQueue* self)
+{
+    self->entries = (TokenQueueEntry*) malloc(TOKEN_QUEUE_CAPACITY * sizeof(TokenQueueEntry));
+    self->tail = 0;
+    self->headSeen = 0;
+    self->head = 0;
+    self->tailSeen = 0;
+    self->publishedTail = 0;
+    self->publishedHead = 0;
+    self->closed = 0;
+}
+
+void token_queue_free(TokenQueue* self)
+{
+    for (size_t i = self->head; i != self->tail; ++i)
+        free(self->entries[i & TQ_MASK].errorMessage);
+    free(self->entries);
+}
+
+// Called after a failed check: spins first, as the other side is likely running
+void _tq_wait(unsigned* spins)
+{
+    if (++*spins >= TQ_SPINS)
+    {
+        sched_yield();
+        *spins = 0;
+    }
+}
+
+// Waits until the entry at tail is free
+int _tq_reserve(TokenQueue* self)
+{
+    unsigned spins = 0;
+    while (self->tail - self->headSeen == TOKEN_QUEUE_CAPACITY)
+    {
+        if (self->publishedTail != self->tail)
+            token_queue_flush(self); // the consumer may be waiting for them
+        if (__atomic_load_n(&self->closed, __ATOMIC_RELAXED))
+            return 0;
+        self->headSeen = __atomic_load_n(&self->publishedHead, __ATOMIC_ACQUIRE);
+        if (self->tail - self->headSeen == TOKEN_QUEUE_CAPACITY)
+            _tq_wait(&spins);
+    }
+    return 1;
+}
+
+void _tq_commit(TokenQueue* self)
+{
+    if (++self->tail - self->publishedTail >= TOKEN_QUEUE_BATCH)
+        token_queue_flush(self);
+}
+
+int token_queue_push(TokenQueue* self, const Token* t)
+{
+    if (!_tq_reserve(self))
+        return 0;
+    TokenQueueEntry* entry = &self->entries[self->tail & TQ_MASK];
+    entry->token = *t;
+    entry->errorMessage = NULL;
+    _tq_commit(self);
+    return 1;
+}
+
+int token_queue_pushError(TokenQueue* self, uint32_t offset, const char* message)
+{
+    if (!_tq_reserve(self))
+        return 0;
+    size_t length = strlen(message);
+    TokenQueueEntry* entry = &self->entries[self->tail & TQ_MASK];
+    entry->token.type = TokenType_END_OF_FILE;
+    entry->token.offset = offset;
+    entry->errorMessage = (char*) malloc((length + 1) * sizeof(char));
+    memcpy(entry->errorMessage, message, length + 1);
+    _tq_commit(self);
+    return 1;
+}
+
+void token_queue_flush(TokenQueue* self)
+{
+    __atomic_store_n(&self->publishedTail, self->tail, __ATOMIC_RELEASE);
+}
+
+TokenQueueEntry token_queue_pop(TokenQueue* self)
+{
+    unsigned spins = 0;
+    while (self->head == self->tailSeen)
+    {
+        if (self->head != self->publishedHead)
+            __atomic_store_n(&self->publishedHead, self->head, __ATOMIC_RELEASE);
+        self->tailSeen = __atomic_load_n(&self->publishedTail, __ATOMIC_ACQUIRE);
+        if (self->head == self->tailSeen)
+            _tq_wait(&spins);
+    }
+
+    TokenQueueEntry entry = self->entries[self->head & TQ_MASK];
+    if (++self->head % TOKEN_QUEUE_BATCH == 0)
+        __atomic_store_n(&self->publishedHead, self->head, __ATOMIC_RELEASE);
+    return entry;
+}
+
+void token_queue_close(TokenQueue* self)
+{
+    __atomic_store_n(&self->closed, 1, __ATOMIC_RELAXED);
+}
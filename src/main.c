@@ -8,33 +8,195 @@
 * September 2023
 */
 
+#include "ast/ast.h"
+#include "codegen/x86_64.h"
+#include "ir/ir.h"
 #include "lexical/lexical_analyzer.h"
 #include "lexical/token.h"
+#include "lexical/token_buffer.h"
 #include "symbol_table/symbol_table.h"
+#include "syntactic/constant_folding.h"
 #include "syntactic/syntactic_analyzer.h"
+#include "util/alloc_stats.h"
+#include "util/arena.h"
+#include "util/diagnostics.h"
+#include "util/interner.h"
 
-#include <glib.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h> // STDIN_FILENO, unlink
+
+void _main_showUsageAndExit(const char* program)
+{
+    fprintf(stderr, "Usage: \"%s [--tokenize-all] [--pipeline] [--max-errors N] [--print-ast] [--print-ir] [--no-optimize] [--emit-asm FILE] [-o FILE] source_filepath\" (\"-\" reads stdin).\n", program);
+    exit(-1);
+}
+
+// Writes the assembly of ir to asmPath, and links it into exePath, each unless NULL. Without
+// asmPath, the assembly goes to a temporary file. Returns the exit status
+int _main_compile(const Ir* ir, const Interner* interner, const char* asmPath, const char* exePath)
+{
+    char tempPath[] = "/tmp/compilerXXXXXX.s";
+    FILE* out;
+    if (asmPath != NULL)
+    {
+        out = fopen(asmPath, "w");
+    }
+    else
+    {
+        int fd = mkstemps(tempPath, 2);
+        out = fd < 0 ? NULL : fdopen(fd, "w");
+        asmPath = tempPath;
+    }
+    if (out == NULL)
+    {
+        fprintf(stderr, "Could not write \"%s\".\n", asmPath);
+        return -1;
+    }
+    x86_64_emit(ir, interner, out);
+    int status = fclose(out) == 0 ? 0 : -1;
+    if (status == 0 && exePath != NULL)
+        status = x86_64_link(asmPath, exePath);
+    if (asmPath == tempPath)
+        unlink(tempPath);
+    return status;
+}
 
 int main(int argc, char** argv)
 {
-    if (argc < 2)
+    // --tokenize-all: lex the whole file before parsing, instead of on demand
+    // --pipeline: lex on a thread of its own, while parsing
+    // --max-errors N: stop after N errors (1 by default). Parsing goes on after each of the others
+    // --print-ast: print the syntax tree of a valid program
+    // --print-ir: print the three address code of a valid program
+    // --no-optimize: generate the code as written, only folding constant expressions
+    // --emit-asm FILE: write the x86-64 assembly of a valid program to FILE
+    // -o FILE: compile a valid program to the executable FILE
+    int tokenizeAll = 0;
+    int pipeline = 0;
+    int printAst = 0;
+    int printIr = 0;
+    int optimize = 1;
+    const char* asmPath = NULL;
+    const char* exePath = NULL;
+    unsigned maxErrors = 1;
+    int i = 1;
+    for (; i < argc - 1; ++i)
     {
-        fprintf(stderr, "Usage: \"%s source_filepath\".\n", argv[0]);
-        exit(-1);
+        if (strcmp(argv[i], "--tokenize-all") == 0)
+        {
+            tokenizeAll = 1;
+        }
+        else if (strcmp(argv[i], "--pipeline") == 0)
+        {
+            pipeline = 1;
+        }
+        else if (strcmp(argv[i], "--max-errors") == 0 && i + 1 < argc - 1)
+        {
+            char* endptr;
+            long n = strtol(argv[++i], &endptr, 10);
+            if (*endptr != '\0' || n < 1 || n > 1000000)
+                _main_showUsageAndExit(argv[0]);
+            maxErrors = (unsigned) n;
+        }
+        else if (strcmp(argv[i], "--print-ast") == 0)
+        {
+            printAst = 1;
+        }
+        else if (strcmp(argv[i], "--print-ir") == 0)
+        {
+            printIr = 1;
+        }
+        else if (strcmp(argv[i], "--no-optimize") == 0)
+        {
+            optimize = 0;
+        }
+        else if (strcmp(argv[i], "--emit-asm") == 0 && i + 1 < argc - 1)
+        {
+            asmPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc - 1)
+        {
+            exePath = argv[++i];
+        }
+        else
+        {
+            _main_showUsageAndExit(argv[0]);
+        }
     }
+    if (i != argc - 1)
+        _main_showUsageAndExit(argv[0]);
+    char* filepath = argv[argc - 1];
+    ALLOC_STATS_START();
 
-    LexicalAnalyzer* la = lexical_analyzer_new(argv[1]);
-    GHashTable* st = symbol_table_new();
-    SyntacticAnalyzer* sa = syntactic_analyzer_new(st, la);
+    Diagnostics* diagnostics = diagnostics_new(maxErrors);
+    // Interned strings of the whole compilation, freed at once at the end
+    Arena* arena = arena_new();
+    Interner* interner = interner_new(arena);
+    LexicalAnalyzer* la;
+    if (strcmp(filepath, "-") == 0)
+        la = lexical_analyzer_newFromFd(STDIN_FILENO, interner);
+    else
+        la = lexical_analyzer_new(filepath, interner);
+    lexical_analyzer_setDiagnostics(la, diagnostics);
+    SymbolTable* st = symbol_table_new();
+    Ast ast;
+    ast_init(&ast);
+    TokenBuffer tokens;
+    SyntacticAnalyzer* sa;
+    if (tokenizeAll)
+    {
+        ALLOC_STATS_PHASE(AllocPhase_TOKENIZE);
+        lexical_analyzer_tokenizeAll(la, &tokens);
+        sa = syntactic_analyzer_newFromTokens(st, &ast, la, &tokens, interner, diagnostics);
+    }
+    else
+    {
+        if (pipeline)
+            lexical_analyzer_startThread(la);
+        sa = syntactic_analyzer_new(st, &ast, la, interner, diagnostics);
+    }
 
     syntactic_analyzer_start(sa);
+    int status = 0;
+    if (diagnostics_count(diagnostics) > 0)
+    {
+        diagnostics_flush(diagnostics);
+        status = -1;
+    }
+    else
+    {
+        if (printAst)
+            ast_print(&ast, interner);
+        if (printIr || asmPath != NULL || exePath != NULL)
+        {
+            ALLOC_STATS_PHASE(AllocPhase_CODE_GENERATION);
+            if (optimize)
+                constant_folding_propagate(&ast, interner);
+            Ir ir;
+            ir_init(&ir);
+            ir_generate(&ir, &ast, interner);
+            if (optimize)
+                ir_optimize(&ir);
+            if (printIr)
+                ir_print(&ir, interner);
+            if (asmPath != NULL || exePath != NULL)
+                status = _main_compile(&ir, interner, asmPath, exePath);
+            ir_free(&ir);
+        }
+    }
 
+    ALLOC_STATS_PHASE(AllocPhase_TEARDOWN);
     syntactic_analyzer_destroy(sa);
+    if (tokenizeAll)
+        token_buffer_free(&tokens);
     lexical_analyzer_destroy(la);
+    ast_free(&ast);
     symbol_table_destroy(st);
+    interner_destroy(interner);
+    arena_destroy(arena);
+    diagnostics_destroy(diagnostics);
 
-    return 0;
+    return status;
 }
@@ -9,12 +9,25 @@
 */
 
 #include "symbol_table/symbol_table.h"
+#include "util/interner.h"
 
 #include <assert.h>
-#include <glib.h>
 #include <stdio.h>
 #include <stdlib.h>
 
+#define SYMBOL_TABLE_INITIAL_SLOTS_LOG2 8
+#define SYMBOL_TABLE_INITIAL_SLOTS (1u << SYMBOL_TABLE_INITIAL_SLOTS_LOG2)
+#define SYMBOL_TABLE_INITIAL_UNDO 64
+#define SYMBOL_TABLE_INITIAL_SCOPES 16
+
+// Declaration made in a nested scope
+typedef struct SymbolTableUndo
+{
+    uint32_t symbolId;
+    int shadows; // if previous is the outer declaration to restore, otherwise the name is removed
+    SymbolTableEntry previous;
+} SymbolTableUndo;
+
 const char* data_type_toString(DataType dt)
 {
     const char* str;
@@ -63,81 +76,146 @@ const char* data_type_toUserString(DataType dt)
     return str;
 }
 
-char* _st_keyToString(const SymbolTableKey* key)
-{   
-    return key->lex;
+SymbolTable* symbol_table_new(void)
+{
+    SymbolTable* st = (SymbolTable*) malloc(sizeof(SymbolTable));
+    st->slots = (SymbolTableSlot*) calloc(SYMBOL_TABLE_INITIAL_SLOTS, sizeof(SymbolTableSlot));
+    st->slotMask = SYMBOL_TABLE_INITIAL_SLOTS - 1;
+    st->shift = 32 - SYMBOL_TABLE_INITIAL_SLOTS_LOG2;
+    st->size = 0;
+    st->level = 0;
+    st->undo = (SymbolTableUndo*) malloc(SYMBOL_TABLE_INITIAL_UNDO * sizeof(SymbolTableUndo));
+    st->undoSize = 0;
+    st->undoCapacity = SYMBOL_TABLE_INITIAL_UNDO;
+    st->scopeStarts = (size_t*) malloc(SYMBOL_TABLE_INITIAL_SCOPES * sizeof(size_t));
+    st->scopeCapacity = SYMBOL_TABLE_INITIAL_SCOPES;
+    return st;
 }
 
-unsigned _st_hash_func(const void* key)
+void symbol_table_destroy(SymbolTable* self)
 {
-    const SymbolTableKey* stKey = (const SymbolTableKey*) key;
-    char* keyStr = _st_keyToString(stKey);
-    unsigned ret = g_str_hash(keyStr);
-    // IF KEY IS MODIFIED TO BE OTHER THAN LEX, KEYS HAVE TO BE PROPERLY DELETED
-    return ret;
+    free(self->scopeStarts);
+    free(self->undo);
+    free(self->slots);
+    free(self);
 }
 
-int _st_key_equal_func(const void* k1, const void* k2)
+void _st_grow(SymbolTable* self)
 {
-    const SymbolTableKey* stKey1 = (const SymbolTableKey*) k1;
-    const SymbolTableKey* stKey2 = (const SymbolTableKey*) k2;
-
-    char* key1Str = _st_keyToString(stKey1);
-    char* key2Str = _st_keyToString(stKey2);
-
-    int res = g_str_equal(key1Str, key2Str);
+    SymbolTableSlot* oldSlots = self->slots;
+    uint32_t oldCount = self->slotMask + 1;
 
-    // IF KEY IS MODIFIED TO BE OTHER THAN LEX, KEYS HAVE TO BE PROPERLY DELETED
-
-    return res;
+    self->slotMask = self->slotMask * 2 + 1;
+    --self->shift;
+    self->slots = (SymbolTableSlot*) calloc((size_t) self->slotMask + 1, sizeof(SymbolTableSlot));
+    for (uint32_t j = 0; j < oldCount; ++j)
+    {
+        if (oldSlots[j].key == 0)
+            continue;
+        uint32_t i = symbol_table_hash(self, oldSlots[j].key - 1);
+        while (self->slots[i].key != 0)
+            i = (i + 1) & self->slotMask;
+        self->slots[i] = oldSlots[j];
+    }
+    free(oldSlots);
 }
 
-void _st_key_destroy_func(void* key)
+// Slot of symbolId, or of the empty slot ending its probe sequence
+uint32_t _st_find(const SymbolTable* self, uint32_t symbolId)
 {
-    SymbolTableKey* stKey = (SymbolTableKey*) key;
-    free(stKey->lex);
-    free(stKey);
+    uint32_t i = symbol_table_hash(self, symbolId);
+    while (self->slots[i].key != 0 && self->slots[i].key != symbolId + 1)
+        i = (i + 1) & self->slotMask;
+    return i;
 }
 
-void _st_value_destroy_func(void* value)
+// Backward shift deletion: later slots of the cluster that may sit in i are moved back,
+// so no tombstones are left to lengthen the probes
+void _st_remove(SymbolTable* self, uint32_t i)
 {
-    free(value);
+    uint32_t j = i;
+    for (;;)
+    {
+        j = (j + 1) & self->slotMask;
+        if (self->slots[j].key == 0)
+            break;
+        uint32_t home = symbol_table_hash(self, self->slots[j].key - 1);
+        if (((j - home) & self->slotMask) >= ((j - i) & self->slotMask))
+        {
+            self->slots[i] = self->slots[j];
+            i = j;
+        }
+    }
+    self->slots[i].key = 0;
+    --self->size;
 }
 
-SymbolTableKey* symbol_table_createKey(char* lex)
+SymbolTableEntry* symbol_table_insert(SymbolTable* self, uint32_t symbolId, DataType dt)
 {
-    SymbolTableKey* stKeyPtr = (SymbolTableKey*) malloc(sizeof(SymbolTableKey));
-    stKeyPtr->lex = lex;
-    return stKeyPtr;
-}
+    // Keep load factor under 1/2
+    if ((self->size + 1) * 2 > self->slotMask)
+        _st_grow(self);
 
-SymbolTableEntry* symbol_table_createEntry(DataType dt)
-{
-    SymbolTableEntry* stEntryPtr = (SymbolTableEntry*) malloc(sizeof(SymbolTableEntry));
-    stEntryPtr->dtype = dt;
-    return stEntryPtr;
-}
+    SymbolTableSlot* slot = &self->slots[_st_find(self, symbolId)];
+    assert(slot->key == 0 || slot->entry.level < self->level);
 
-GHashTable* symbol_table_new()
-{
-    GHashTable* st = g_hash_table_new_full(_st_hash_func, _st_key_equal_func, _st_key_destroy_func, _st_value_destroy_func);
-    return st;
+    // Class declarations are never undone
+    if (self->level > 0)
+    {
+        if (self->undoSize == self->undoCapacity)
+        {
+            self->undoCapacity *= 2;
+            self->undo = (SymbolTableUndo*) realloc(self->undo, self->undoCapacity * sizeof(SymbolTableUndo));
+        }
+        SymbolTableUndo* undo = &self->undo[self->undoSize++];
+        undo->symbolId = symbolId;
+        undo->shadows = slot->key != 0;
+        undo->previous = slot->entry;
+    }
+
+    if (slot->key == 0)
+    {
+        slot->key = symbolId + 1;
+        ++self->size;
+    }
+    slot->entry.dtype = dt;
+    slot->entry.level = self->level;
+    return &slot->entry;
 }
 
-void symbol_table_destroy(GHashTable* self)
+void symbol_table_enterScope(SymbolTable* self)
 {
-    g_hash_table_destroy(self);
+    if (self->level == self->scopeCapacity)
+    {
+        self->scopeCapacity *= 2;
+        self->scopeStarts = (size_t*) realloc(self->scopeStarts, self->scopeCapacity * sizeof(size_t));
+    }
+    self->scopeStarts[self->level] = self->undoSize;
+    ++self->level;
 }
 
-void _st_hash_table_printf_foreach(void* key, void* value, void* userData)
+void symbol_table_exitScope(SymbolTable* self)
 {
-    value = value; // remove warnings. this is intentional, as they will not be used but are required for the API
-    userData = userData;
-    SymbolTableKey* stKey = (SymbolTableKey*) key;
-    printf("SymbolTable key: lex: %s\n", stKey->lex);
+    assert(self->level > 0);
+    --self->level;
+    size_t start = self->scopeStarts[self->level];
+    while (self->undoSize > start)
+    {
+        const SymbolTableUndo* undo = &self->undo[--self->undoSize];
+        uint32_t i = _st_find(self, undo->symbolId);
+        assert(self->slots[i].key == undo->symbolId + 1);
+        if (undo->shadows)
+            self->slots[i].entry = undo->previous;
+        else
+            _st_remove(self, i);
+    }
 }
 
-void symbol_table_print(GHashTable* self)
+void symbol_table_print(const SymbolTable* self, const Interner* interner)
 {
-    g_hash_table_foreach(self, _st_hash_table_printf_foreach, NULL);
+    for (uint32_t i = 0; i <= self->slotMask; ++i)
+    {
+        if (self->slots[i].key != 0)
+            printf("SymbolTable key: lex: %s\n", interner_getString(interner, self->slots[i].key - 1));
+    }
 }
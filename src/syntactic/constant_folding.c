@@ -0,0 +1,459 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "syntactic/constant_folding.h"
+
+#include "util/interner.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Expression node waiting for its operands to be folded
+typedef struct CfFrame
+{
+    AstIndex node;
+    int expanded; // its operands were pushed
+} CfFrame;
+
+// Children of a block being folded, or the condition of a do waiting for its body
+typedef struct CfStmtFrame
+{
+    AstIndex node; // parent of the children, or the condition
+    AstIndex next; // child to fold next
+    uint32_t markedStart; // of the values made known by the children
+    int kind; // CF_STMT_*
+} CfStmtFrame;
+
+#define CF_STMT_KEEP_KNOWN 0 // children whose values stay known after them
+#define CF_STMT_FORGET_KNOWN 1
+#define CF_STMT_CONDITION 2
+
+typedef struct ConstantFolding
+{
+    Ast* ast;
+    struct Interner* interner;
+    uint32_t* assignments; // count of ASSIGN and READ of each DECL node
+    AstIndex* known; // CONSTANT node with the value of each DECL node, AST_NONE if not known
+    AstIndex* marked; // DECL nodes made known, in order, to forget them as their scope ends
+    uint32_t markedSize;
+
+    CfFrame* stack;
+    uint32_t stackSize;
+    uint32_t stackCapacity;
+    CfStmtFrame* stmts;
+    uint32_t stmtSize;
+    uint32_t stmtCapacity;
+} ConstantFolding;
+
+// Replaces node by a constant, which keeps its place among its siblings
+void _cf_setConstant(Ast* ast, AstIndex dst, const AstNode* value)
+{
+    AstNode* node = &ast->nodes[dst];
+    AstIndex sibling = node->sibling;
+    uint32_t offset = node->offset;
+    *node = *value;
+    node->kind = AstKind_CONSTANT;
+    node->op = 0;
+    node->offset = offset;
+    node->child = AST_NONE;
+    node->sibling = sibling;
+}
+
+// As a condition of the generated code: NaN is true
+int _cf_isTrue(const AstNode* constant)
+{
+    if (constant->dtype == DataType_FLOAT)
+        return islessgreater(constant->realVal, 0.0) || isunordered(constant->realVal, 0.0);
+    return constant->intVal != 0;
+}
+
+double _cf_toFloat(const AstNode* constant)
+{
+    return constant->dtype == DataType_FLOAT ? constant->realVal : (double) constant->intVal;
+}
+
+// Relational operators, on operands of the same type. Returns -1 if it does not fold
+int _cf_compare(const AstNode* l, const AstNode* r, TokenType op)
+{
+    if (l->dtype == DataType_STRING)
+    {
+        // Interned: equal strings have the same id
+        if (op == TokenType_EQUALS)
+            return l->literalId == r->literalId;
+        if (op == TokenType_NOT_EQUALS)
+            return l->literalId != r->literalId;
+        return -1;
+    }
+    if (l->dtype == DataType_FLOAT)
+    {
+        double a = l->realVal;
+        double b = r->realVal;
+        switch (op)
+        {
+        case TokenType_EQUALS:
+            return !islessgreater(a, b) && !isunordered(a, b);
+        case TokenType_NOT_EQUALS:
+            return islessgreater(a, b) || isunordered(a, b);
+        case TokenType_LOWER:
+            return isless(a, b);
+        case TokenType_LOWER_EQ:
+            return islessequal(a, b);
+        case TokenType_GREATER:
+            return isgreater(a, b);
+        case TokenType_GREATER_EQ:
+            return isgreaterequal(a, b);
+        default:
+            return -1;
+        }
+    }
+    if (l->dtype != DataType_INT)
+        return -1;
+    long a = l->intVal;
+    long b = r->intVal;
+    switch (op)
+    {
+    case TokenType_EQUALS:
+        return a == b;
+    case TokenType_NOT_EQUALS:
+        return a != b;
+    case TokenType_LOWER:
+        return a < b;
+    case TokenType_LOWER_EQ:
+        return a <= b;
+    case TokenType_GREATER:
+        return a > b;
+    case TokenType_GREATER_EQ:
+        return a >= b;
+    default:
+        return -1;
+    }
+}
+
+// Arithmetic of ints and booleans wraps around, as in the generated code
+int _cf_intArithmetic(long a, long b, TokenType op, long* result)
+{
+    unsigned long ua = (unsigned long) a;
+    unsigned long ub = (unsigned long) b;
+    switch (op)
+    {
+    case TokenType_ADD:
+        *result = (long) (ua + ub);
+        return 1;
+    case TokenType_SUB:
+        *result = (long) (ua - ub);
+        return 1;
+    case TokenType_MUL:
+        *result = (long) (ua * ub);
+        return 1;
+    case TokenType_DIV:
+        // Left to trap at run time
+        if (b == 0 || (a == LONG_MIN && b == -1))
+            return 0;
+        *result = a / b;
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+int _cf_concat(const AstNode* l, const AstNode* r, struct Interner* interner, uint32_t* literalId)
+{
+    unsigned lLength = interner_getLength(interner, l->literalId);
+    unsigned rLength = interner_getLength(interner, r->literalId);
+    if (lLength > UINT_MAX - rLength)
+        return 0;
+    char* str = (char*) malloc((size_t) lLength + rLength + 1);
+    memcpy(str, interner_getString(interner, l->literalId), lLength);
+    memcpy(str + lLength, interner_getString(interner, r->literalId), rLength);
+    *literalId = interner_intern(interner, str, lLength + rLength);
+    free(str);
+    return 1;
+}
+
+int constant_folding_binary(Ast* ast, AstIndex dst, AstIndex left, TokenType op, AstIndex right, DataType dt, struct Interner* interner)
+{
+    const AstNode* l = &ast->nodes[left];
+    const AstNode* r = &ast->nodes[right];
+    if (l->kind != AstKind_CONSTANT || r->kind != AstKind_CONSTANT)
+        return 0;
+
+    AstNode value = {0};
+    value.dtype = (uint8_t) dt;
+    switch (op)
+    {
+    case TokenType_EQUALS:
+    case TokenType_NOT_EQUALS:
+    case TokenType_LOWER:
+    case TokenType_LOWER_EQ:
+    case TokenType_GREATER:
+    case TokenType_GREATER_EQ:
+    {
+        int result = l->dtype == r->dtype ? _cf_compare(l, r, op) : -1;
+        if (result < 0)
+            return 0;
+        value.dtype = DataType_BOOLEAN;
+        value.intVal = result;
+        break;
+    }
+    case TokenType_ADD:
+    case TokenType_SUB:
+    case TokenType_MUL:
+    case TokenType_DIV:
+        if (dt == DataType_FLOAT)
+        {
+            // Operands of a chain starting with a division may be ints
+            if (l->dtype == DataType_STRING || l->dtype == DataType_BOOLEAN ||
+                r->dtype == DataType_STRING || r->dtype == DataType_BOOLEAN)
+            {
+                return 0;
+            }
+            double a = _cf_toFloat(l);
+            double b = _cf_toFloat(r);
+            if (op == TokenType_ADD)
+                value.realVal = a + b;
+            else if (op == TokenType_SUB)
+                value.realVal = a - b;
+            else if (op == TokenType_MUL)
+                value.realVal = a * b;
+            else
+                value.realVal = a / b;
+        }
+        else if (l->dtype != dt || r->dtype != dt)
+        {
+            return 0;
+        }
+        else if (dt == DataType_STRING)
+        {
+            if (op != TokenType_ADD || !_cf_concat(l, r, interner, &value.literalId))
+                return 0;
+        }
+        else if (!_cf_intArithmetic(l->intVal, r->intVal, op, &value.intVal))
+        {
+            return 0;
+        }
+        break;
+    case TokenType_AND:
+    case TokenType_OR:
+    {
+        if (l->dtype != dt || r->dtype != dt || dt == DataType_STRING)
+            return 0;
+        int result = op == TokenType_AND ? _cf_isTrue(l) && _cf_isTrue(r) : _cf_isTrue(l) || _cf_isTrue(r);
+        if (dt == DataType_FLOAT)
+            value.realVal = result;
+        else
+            value.intVal = result;
+        break;
+    }
+    default:
+        return 0;
+    }
+    _cf_setConstant(ast, dst, &value);
+    return 1;
+}
+
+int constant_folding_unary(Ast* ast, AstIndex dst, TokenType op, AstIndex operand)
+{
+    const AstNode* x = &ast->nodes[operand];
+    if (x->kind != AstKind_CONSTANT)
+        return 0;
+
+    AstNode value = {0};
+    value.dtype = x->dtype;
+    if (op == TokenType_NOT && x->dtype == DataType_BOOLEAN)
+        value.intVal = x->intVal == 0;
+    else if (op == TokenType_SUB && x->dtype == DataType_INT)
+        value.intVal = (long) (0ul - (unsigned long) x->intVal);
+    else if (op == TokenType_SUB && x->dtype == DataType_FLOAT)
+        value.realVal = -x->realVal;
+    else
+        return 0;
+    _cf_setConstant(ast, dst, &value);
+    return 1;
+}
+
+void _cf_push(ConstantFolding* self, AstIndex node)
+{
+    if (self->stackSize == self->stackCapacity)
+    {
+        self->stackCapacity *= 2;
+        self->stack = (CfFrame*) realloc(self->stack, self->stackCapacity * sizeof(CfFrame));
+    }
+    self->stack[self->stackSize].node = node;
+    self->stack[self->stackSize].expanded = 0;
+    ++self->stackSize;
+}
+
+// Without recursion: operator chains make trees as deep as they are long
+void _cf_expr(ConstantFolding* self, AstIndex root)
+{
+    Ast* ast = self->ast;
+    _cf_push(self, root);
+    while (self->stackSize > 0)
+    {
+        CfFrame* frame = &self->stack[self->stackSize - 1];
+        AstIndex index = frame->node;
+        const AstNode* node = &ast->nodes[index];
+        if (!frame->expanded && (node->kind == AstKind_BINARY || node->kind == AstKind_UNARY))
+        {
+            frame->expanded = 1;
+            if (node->kind == AstKind_BINARY)
+                _cf_push(self, ast->nodes[node->child].sibling);
+            _cf_push(self, node->child);
+            continue;
+        }
+        --self->stackSize;
+
+        if (node->kind == AstKind_ID)
+        {
+            AstIndex value = self->known[node->var.decl];
+            if (value != AST_NONE)
+                _cf_setConstant(ast, index, &ast->nodes[value]);
+        }
+        else if (node->kind == AstKind_BINARY)
+        {
+            AstIndex left = node->child;
+            constant_folding_binary(ast, index, left, (TokenType) node->op, ast->nodes[left].sibling, (DataType) node->dtype, self->interner);
+        }
+        else if (node->kind == AstKind_UNARY)
+        {
+            constant_folding_unary(ast, index, (TokenType) node->op, node->child);
+        }
+    }
+}
+
+void _cf_pushStmts(ConstantFolding* self, AstIndex node, int kind)
+{
+    if (self->stmtSize == self->stmtCapacity)
+    {
+        self->stmtCapacity *= 2;
+        self->stmts = (CfStmtFrame*) realloc(self->stmts, self->stmtCapacity * sizeof(CfStmtFrame));
+    }
+    CfStmtFrame* frame = &self->stmts[self->stmtSize++];
+    frame->node = node;
+    frame->next = kind == CF_STMT_CONDITION ? AST_NONE : self->ast->nodes[node].child;
+    frame->markedStart = self->markedSize;
+    frame->kind = kind;
+}
+
+// Blocks are pushed, to be folded after it
+void _cf_stmt(ConstantFolding* self, AstIndex index)
+{
+    Ast* ast = self->ast;
+    AstNode* node = &ast->nodes[index];
+    switch ((AstKind) node->kind)
+    {
+    case AstKind_ASSIGN:
+    {
+        _cf_expr(self, node->child);
+        AstIndex decl = node->var.decl;
+        if (self->assignments[decl] == 1 && ast->nodes[node->child].kind == AstKind_CONSTANT)
+        {
+            self->known[decl] = node->child;
+            self->marked[self->markedSize++] = decl;
+        }
+        break;
+    }
+    case AstKind_IF:
+    {
+        AstIndex condition = node->child;
+        AstIndex thenBlock = ast->nodes[condition].sibling;
+        _cf_expr(self, condition);
+        // The then block first: it forgets its values before the else one starts
+        if (ast->nodes[thenBlock].sibling != AST_NONE)
+            _cf_pushStmts(self, ast->nodes[thenBlock].sibling, CF_STMT_FORGET_KNOWN);
+        _cf_pushStmts(self, thenBlock, CF_STMT_FORGET_KNOWN);
+        break;
+    }
+    case AstKind_DO:
+        _cf_pushStmts(self, ast->nodes[node->child].sibling, CF_STMT_CONDITION);
+        _cf_pushStmts(self, node->child, CF_STMT_KEEP_KNOWN);
+        break;
+    case AstKind_WRITE:
+        _cf_expr(self, node->child);
+        break;
+    case AstKind_BLOCK:
+        _cf_pushStmts(self, index, CF_STMT_KEEP_KNOWN);
+        break;
+    default: // DECL and READ
+        break;
+    }
+}
+
+// Without recursion, as blocks nest without limit. Values known from the children of a
+// block are forgotten as they end, unless they certainly ran: the ones of a do body run at
+// least once
+void _cf_stmts(ConstantFolding* self, AstIndex root)
+{
+    _cf_pushStmts(self, root, CF_STMT_KEEP_KNOWN);
+    while (self->stmtSize > 0)
+    {
+        CfStmtFrame* frame = &self->stmts[self->stmtSize - 1];
+        if (frame->next != AST_NONE)
+        {
+            AstIndex child = frame->next;
+            frame->next = self->ast->nodes[child].sibling;
+            _cf_stmt(self, child);
+            continue;
+        }
+
+        --self->stmtSize;
+        if (frame->kind == CF_STMT_CONDITION)
+        {
+            _cf_expr(self, frame->node);
+        }
+        else if (frame->kind == CF_STMT_FORGET_KNOWN)
+        {
+            while (self->markedSize > frame->markedStart)
+                self->known[self->marked[--self->markedSize]] = AST_NONE;
+        }
+    }
+}
+
+void constant_folding_propagate(Ast* ast, struct Interner* interner)
+{
+    if (ast->size == 0)
+        return;
+
+    ConstantFolding cf;
+    cf.ast = ast;
+    cf.interner = interner;
+    cf.assignments = (uint32_t*) calloc(ast->size, sizeof(uint32_t));
+    cf.known = (AstIndex*) malloc(ast->size * sizeof(AstIndex));
+    uint32_t assignCount = 0;
+    for (AstIndex i = 0; i < ast->size; ++i)
+    {
+        const AstNode* node = &ast->nodes[i];
+        cf.known[i] = AST_NONE;
+        if ((node->kind == AstKind_ASSIGN || node->kind == AstKind_READ) && node->var.decl != AST_NONE)
+        {
+            ++cf.assignments[node->var.decl];
+            ++assignCount;
+        }
+    }
+    // Each variable is made known once, at its assignment
+    cf.marked = (AstIndex*) malloc((assignCount + 1) * sizeof(AstIndex));
+    cf.markedSize = 0;
+    cf.stackCapacity = 64;
+    cf.stack = (CfFrame*) malloc(cf.stackCapacity * sizeof(CfFrame));
+    cf.stackSize = 0;
+    cf.stmtCapacity = 64;
+    cf.stmts = (CfStmtFrame*) malloc(cf.stmtCapacity * sizeof(CfStmtFrame));
+    cf.stmtSize = 0;
+
+    _cf_stmts(&cf, 0);
+
+    free(cf.stmts);
+    free(cf.stack);
+    free(cf.marked);
+    free(cf.known);
+    free(cf.assignments);
+}
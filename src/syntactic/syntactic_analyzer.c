@@ -10,78 +10,251 @@
 
 #include "syntactic/syntactic_analyzer.h"
 
+#include "ast/ast.h"
 #include "lexical/lexical_analyzer.h"
 #include "lexical/token.h"
+#include "lexical/token_buffer.h"
 #include "symbol_table/symbol_table.h"
+#include "syntactic/constant_folding.h"
+#include "util/alloc_stats.h"
+#include "util/diagnostics.h"
+#include "util/interner.h"
+
+#include "syntactic_ll1_table.h" // generated from grammar/syntactic.ll1
 
 #include <assert.h>
+#include <setjmp.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// Of each stack of the parser, allocated with it. Deeper nesting doubles them
+#define SA_STACK_INITIAL_CAPACITY 256
+
+// Whether symbol starts or ends a declaration or statement on the parser stack
+#define SA_IS_UNIT_START(symbol) ((symbol) == (SA_LL1_ACTION | SaAction_DECL_UNIT) || (symbol) == (SA_LL1_ACTION | SaAction_STMT_UNIT))
+#define SA_IS_UNIT_END(symbol) ((symbol) == (SA_LL1_ACTION | SaAction_DECL_END) || (symbol) == (SA_LL1_ACTION | SaAction_STMT_END))
+
+// Errors of the rules without a default alternative (sa_ll1_default)
+static const char* sa_expected[SaRule_SIZE] =
+{
+    [SaRule_TYPE] = "int, string or float",
+    [SaRule_STMT] = "identifier, if, do, read or write",
+};
+
+// Binary operators by precedence
+#define SA_PRECEDENCE_NONE 0
+#define SA_PRECEDENCE_RELATIONAL 1
+#define SA_PRECEDENCE_ADDITIVE 2
+#define SA_PRECEDENCE_MULTIPLICATIVE 3
+
+#define SA_ASSOCIATIVITY_LEFT 0
+#define SA_ASSOCIATIVITY_NONE 1 // a single operator of its precedence, e.g. "a < b"
+
+#define SA_TYPE_BIT(dt) (1u << (dt))
+#define SA_NUMERIC_TYPES (SA_TYPE_BIT(DataType_INT) | SA_TYPE_BIT(DataType_FLOAT))
+#define SA_OPERAND_TYPE 0xFF // type of the chain is the one of its first operand
+
+typedef struct SaOperator
+{
+    uint8_t precedence; // as a binary operator, SA_PRECEDENCE_NONE if it is not one
+    uint8_t associativity;
+    uint8_t binaryTypes; // allowed types of its right operand, as SA_TYPE_BITs
+    uint8_t unaryTypes; // allowed types of its operand as a prefix operator, 0 if it is not one
+    uint8_t resultType; // of a chain starting with it
+} SaOperator;
+
+// Binary operators only check their right operand: the left one must have the same type.
+// Prefix operators bind tighter than all binary ones, and take a factor
+static const SaOperator sa_operators[TokenType_SIZE] =
+{
+    [TokenType_EQUALS] = {SA_PRECEDENCE_RELATIONAL, SA_ASSOCIATIVITY_NONE, SA_NUMERIC_TYPES | SA_TYPE_BIT(DataType_STRING), 0, DataType_BOOLEAN},
+    [TokenType_NOT_EQUALS] = {SA_PRECEDENCE_RELATIONAL, SA_ASSOCIATIVITY_NONE, SA_NUMERIC_TYPES | SA_TYPE_BIT(DataType_STRING), 0, DataType_BOOLEAN},
+    [TokenType_GREATER] = {SA_PRECEDENCE_RELATIONAL, SA_ASSOCIATIVITY_NONE, SA_NUMERIC_TYPES, 0, DataType_BOOLEAN},
+    [TokenType_GREATER_EQ] = {SA_PRECEDENCE_RELATIONAL, SA_ASSOCIATIVITY_NONE, SA_NUMERIC_TYPES, 0, DataType_BOOLEAN},
+    [TokenType_LOWER] = {SA_PRECEDENCE_RELATIONAL, SA_ASSOCIATIVITY_NONE, SA_NUMERIC_TYPES, 0, DataType_BOOLEAN},
+    [TokenType_LOWER_EQ] = {SA_PRECEDENCE_RELATIONAL, SA_ASSOCIATIVITY_NONE, SA_NUMERIC_TYPES, 0, DataType_BOOLEAN},
+    [TokenType_ADD] = {SA_PRECEDENCE_ADDITIVE, SA_ASSOCIATIVITY_LEFT, SA_NUMERIC_TYPES | SA_TYPE_BIT(DataType_STRING) | SA_TYPE_BIT(DataType_BOOLEAN), 0, SA_OPERAND_TYPE},
+    [TokenType_SUB] = {SA_PRECEDENCE_ADDITIVE, SA_ASSOCIATIVITY_LEFT, SA_NUMERIC_TYPES | SA_TYPE_BIT(DataType_BOOLEAN), SA_NUMERIC_TYPES, SA_OPERAND_TYPE},
+    [TokenType_OR] = {SA_PRECEDENCE_ADDITIVE, SA_ASSOCIATIVITY_LEFT, SA_NUMERIC_TYPES | SA_TYPE_BIT(DataType_BOOLEAN), 0, SA_OPERAND_TYPE},
+    [TokenType_MUL] = {SA_PRECEDENCE_MULTIPLICATIVE, SA_ASSOCIATIVITY_LEFT, SA_NUMERIC_TYPES, 0, SA_OPERAND_TYPE},
+    [TokenType_DIV] = {SA_PRECEDENCE_MULTIPLICATIVE, SA_ASSOCIATIVITY_LEFT, SA_NUMERIC_TYPES, 0, DataType_FLOAT},
+    [TokenType_AND] = {SA_PRECEDENCE_MULTIPLICATIVE, SA_ASSOCIATIVITY_LEFT, SA_TYPE_BIT(DataType_BOOLEAN), 0, SA_OPERAND_TYPE},
+    [TokenType_NOT] = {SA_PRECEDENCE_NONE, SA_ASSOCIATIVITY_LEFT, 0, SA_TYPE_BIT(DataType_BOOLEAN), SA_OPERAND_TYPE},
+};
+
+// Operand, statement or block built by the actions so far
+typedef struct SaValue
+{
+    AstIndex node;
+    DataType dt;
+    uint32_t offset; // of the read
+} SaValue;
+
+// Node whose children are being linked, e.g. a block
+typedef struct SaList
+{
+    AstIndex parent;
+    AstIndex last; // child so far, AST_NONE if none
+} SaList;
+
+// Entry of the operator stack of expressions: the binary operators of one precedence being
+// parsed, e.g. "a * b / c", a prefix operator or an open parenthesis
+typedef struct SaChain
+{
+    AstIndex node; // the chain so far
+    TokenType op; // waiting for its right operand, OPEN_PAR for a parenthesis
+    uint32_t opOffset;
+    uint8_t precedence; // of op, SA_PRECEDENCE_NONE if it is not a binary operator
+    DataType dtype;
+    DataType lastDt; // of the last operand
+    int hasMismatch;
+    DataType mismatch[2]; // last pair of operands of different types
+} SaChain;
+
+// Where parsing resumes after an error in a declaration or statement, after its end on
+// the parser stack: the sizes of the other stacks, and the symbol table scope, at its start
+typedef struct SaRecovery
+{
+    uint32_t valueCount;
+    uint32_t listCount;
+    uint32_t chainCount;
+    uint32_t level;
+    int inDeclarations;
+} SaRecovery;
 
 struct SyntacticAnalyzer
 {
-    GHashTable* symbolTable;
-    LexicalAnalyzer* lexicalAnalyzer;
+    SymbolTable* symbolTable;
+    Ast* ast;
+    LexicalAnalyzer* lexicalAnalyzer; // only locates diagnostics when reading from a token buffer
+    Interner* interner;
+    Diagnostics* diagnostics;
     Token curToken;
+
+    const TokenBuffer* tokens;
+    size_t tokenIndex; // index of curToken
+    size_t tokenError; // next lexical error of tokens to report
+
+    // Parser stack, of the symbols of sa_ll1_symbols still to match
+    uint16_t* symbols;
+    uint32_t symbolCount;
+    uint32_t symbolCapacity;
+    SaValue* values;
+    uint32_t valueCount;
+    uint32_t valueCapacity;
+    SaList* lists;
+    uint32_t listCount;
+    uint32_t listCapacity;
+    SaChain* chains;
+    uint32_t chainCount;
+    uint32_t chainCapacity;
+    SaRecovery* recoveries; // of the declarations and statements being parsed, innermost last
+    uint32_t recoveryCount;
+    uint32_t recoveryCapacity;
+    jmp_buf recoveryEnv; // errors go back to the parser loop through it, if there is a recovery
+
+    DataType declType; // of the declaration being parsed
+    uint32_t lastErrorOffset; // errors following another at the same token are not reported
 };
 
-void _sa_showExpectedErrorAndExit(SyntacticAnalyzer* self, const char* expectedStr)
+// Position reported by diagnostics: the first char of curToken
+SourcePosition _sa_getPosition(const SyntacticAnalyzer* self)
+{
+    return lexical_analyzer_getPosition(self->lexicalAnalyzer, self->curToken.offset);
+}
+
+void _sa_reportError(SyntacticAnalyzer* self, const char* format, ...)
+{
+    if (self->curToken.offset == self->lastErrorOffset)
+        return; // caused by the previous one
+    self->lastErrorOffset = self->curToken.offset;
+
+    SourcePosition position = _sa_getPosition(self);
+    va_list args;
+    va_start(args, format);
+    diagnostics_reportV(self->diagnostics, position.line, position.column, format, args);
+    va_end(args);
+}
+
+// Abandons the statement or declaration being parsed, after its error was reported
+void _sa_fail(SyntacticAnalyzer* self)
+{
+    if (self->recoveryCount == 0)
+        diagnostics_exit(self->diagnostics);
+    longjmp(self->recoveryEnv, 1);
+}
+
+void _sa_showExpectedError(SyntacticAnalyzer* self, const char* expectedStr)
 {
-    unsigned line = lexical_analyzer_getLine(self->lexicalAnalyzer);
-    unsigned column = lexical_analyzer_getColumn(self->lexicalAnalyzer);
     const char* gotTypeStr = token_type_toUserString(self->curToken.type);
-    char* gotLexStr = token_lexemeToString(&self->curToken);
+    char* gotLexStr = token_lexemeToString(&self->curToken, self->interner);
 
-    fprintf(stderr, "Error at line %d column %d: expected \"%s\", got \"%s\"", line, column, expectedStr, gotTypeStr);
     if (gotLexStr)
     {
-        fprintf(stderr, "(%s)", gotLexStr);
+        _sa_reportError(self, "expected \"%s\", got \"%s\"(%s).\n", expectedStr, gotTypeStr, gotLexStr);
         token_destroyLexemeString(gotLexStr);
     }
-    
-    fprintf(stderr, ".\n");
-    exit(-1);
+    else
+    {
+        _sa_reportError(self, "expected \"%s\", got \"%s\".\n", expectedStr, gotTypeStr);
+    }
+    _sa_fail(self);
 }
 
-void _sem_showAlreadyDeclaredIdentifierAndExit(const SyntacticAnalyzer* self, const char* identifierLex)
+// Parsing goes on: the identifier keeps its first declaration
+void _sem_showAlreadyDeclaredIdentifier(SyntacticAnalyzer* self, uint32_t symbolId)
 {
-    unsigned line = lexical_analyzer_getLine(self->lexicalAnalyzer);
-    unsigned column = lexical_analyzer_getColumn(self->lexicalAnalyzer);
-    fprintf(stderr, "Error at line %d column %d: already declared identifier \"%s\".\n", line, column, identifierLex);
-    exit(-1);
+    const char* identifierLex = interner_getString(self->interner, symbolId);
+    _sa_reportError(self, "already declared identifier \"%s\".\n", identifierLex);
 }
 
-void _sem_showUndeclaredIdentifierAndExit(SyntacticAnalyzer* self, const char* identifierLex)
+void _sem_showUndeclaredIdentifier(SyntacticAnalyzer* self, uint32_t symbolId)
 {
-    unsigned line = lexical_analyzer_getLine(self->lexicalAnalyzer);
-    unsigned column = lexical_analyzer_getColumn(self->lexicalAnalyzer);
-    fprintf(stderr, "Error at line %d column %d: use of undeclared identifier \"%s\".\n", line, column, identifierLex);
-    exit(-1);
+    const char* identifierLex = interner_getString(self->interner, symbolId);
+    _sa_reportError(self, "use of undeclared identifier \"%s\".\n", identifierLex);
+    _sa_fail(self);
 }
 
-void _sem_showMismatchedDataTypesAndExit(SyntacticAnalyzer* self, DataType dt1, DataType dt2)
+void _sem_showMismatchedDataTypes(SyntacticAnalyzer* self, DataType dt1, DataType dt2)
 {
-    unsigned line = lexical_analyzer_getLine(self->lexicalAnalyzer);
-    unsigned column = lexical_analyzer_getColumn(self->lexicalAnalyzer);
     const char* dt1Str = data_type_toUserString(dt1);
     const char* dt2Str = data_type_toUserString(dt2);
-    fprintf(stderr, "Error at line %d column %d: DataTypes differs: \"%s\" and \"%s\".\n", line, column, dt1Str, dt2Str);
-    exit(-1);
+    _sa_reportError(self, "DataTypes differs: \"%s\" and \"%s\".\n", dt1Str, dt2Str);
+    _sa_fail(self);
 }
 
-void _sem_showInvalidOperatorAndExit(SyntacticAnalyzer* self, DataType dt, TokenType tt)
+void _sem_showInvalidOperator(SyntacticAnalyzer* self, DataType dt, TokenType tt)
 {
-    unsigned line = lexical_analyzer_getLine(self->lexicalAnalyzer);
-    unsigned column = lexical_analyzer_getColumn(self->lexicalAnalyzer);
     const char* dtStr = data_type_toUserString(dt);
     const char* ttStr = token_type_toUserString(tt);
-    fprintf(stderr, "Error at line %d column %d: DataTypes \"%s\" does not support operator \"%s\".\n", line, column, dtStr, ttStr);
-    exit(-1);
+    _sa_reportError(self, "DataTypes \"%s\" does not support operator \"%s\".\n", dtStr, ttStr);
+    _sa_fail(self);
 }
 
-void _sa_advance(SyntacticAnalyzer* self)
+static inline void _sa_advance(SyntacticAnalyzer* self)
 {
-    self->curToken = lexical_analyzer_getToken(self->lexicalAnalyzer);
+    if (self->tokens)
+    {
+        // Stays on the last token (END_OF_FILE), like the lexer does at the end of input.
+        // tokenIndex starts at (size_t) -1, so the first advance wraps to 0
+        if (self->tokenIndex + 1 < self->tokens->size)
+            ++self->tokenIndex;
+        self->curToken = token_buffer_get(self->tokens, self->tokenIndex);
+
+        // Lexical errors before it, reported when it is reached as on demand lexing does
+        const TokenBuffer* tokens = self->tokens;
+        for (; self->tokenError < tokens->errorCount && tokens->errors[self->tokenError].index <= self->tokenIndex; ++self->tokenError)
+        {
+            const TokenBufferError* error = &tokens->errors[self->tokenError];
+            SourcePosition position = lexical_analyzer_getPosition(self->lexicalAnalyzer, error->offset);
+            diagnostics_report(self->diagnostics, position.line, position.column, "%s", error->message);
+        }
+    }
+    else
+    {
+        self->curToken = lexical_analyzer_getToken(self->lexicalAnalyzer);
+    }
 }
 
 void _sa_eat(SyntacticAnalyzer* self, TokenType type)
@@ -93,573 +266,617 @@ void _sa_eat(SyntacticAnalyzer* self, TokenType type)
     else
     {
         const char* expectedStr = token_type_toUserString(type);
-        _sa_showExpectedErrorAndExit(self, expectedStr);
+        _sa_showExpectedError(self, expectedStr);
     }
 }
 
-SyntacticAnalyzer* syntactic_analyzer_new(GHashTable* st, LexicalAnalyzer* la)
+// Makes room in items, a stack of size of *capacity items, for count more
+void* _sa_reserve(void* items, uint32_t* capacity, uint32_t size, uint32_t count, size_t itemSize)
+{
+    if (size + count <= *capacity)
+        return items;
+    while (size + count > *capacity)
+        *capacity *= 2;
+    return realloc(items, *capacity * itemSize);
+}
+
+void _sa_initStacks(SyntacticAnalyzer* self)
+{
+    self->symbols = (uint16_t*) malloc(SA_STACK_INITIAL_CAPACITY * sizeof(uint16_t));
+    self->symbolCount = 0;
+    self->symbolCapacity = SA_STACK_INITIAL_CAPACITY;
+    self->values = (SaValue*) malloc(SA_STACK_INITIAL_CAPACITY * sizeof(SaValue));
+    self->valueCount = 0;
+    self->valueCapacity = SA_STACK_INITIAL_CAPACITY;
+    self->lists = (SaList*) malloc(SA_STACK_INITIAL_CAPACITY * sizeof(SaList));
+    self->listCount = 0;
+    self->listCapacity = SA_STACK_INITIAL_CAPACITY;
+    self->chains = (SaChain*) malloc(SA_STACK_INITIAL_CAPACITY * sizeof(SaChain));
+    self->chainCount = 0;
+    self->chainCapacity = SA_STACK_INITIAL_CAPACITY;
+    self->recoveries = (SaRecovery*) malloc(SA_STACK_INITIAL_CAPACITY * sizeof(SaRecovery));
+    self->recoveryCount = 0;
+    self->recoveryCapacity = SA_STACK_INITIAL_CAPACITY;
+}
+
+SyntacticAnalyzer* syntactic_analyzer_new(SymbolTable* st, Ast* ast, LexicalAnalyzer* la, Interner* interner, Diagnostics* diagnostics)
 {
     SyntacticAnalyzer* sa = (SyntacticAnalyzer*) malloc(sizeof(SyntacticAnalyzer));
     sa->symbolTable = st;
+    sa->ast = ast;
     sa->lexicalAnalyzer = la;
+    sa->interner = interner;
+    sa->diagnostics = diagnostics;
+    _sa_initStacks(sa);
+    sa->declType = DataType_INT;
+    sa->lastErrorOffset = UINT32_MAX;
+    sa->tokens = NULL;
+    sa->tokenIndex = 0;
+    sa->tokenError = 0;
+    _sa_advance(sa); // init first token
+    return sa;
+}
+
+SyntacticAnalyzer* syntactic_analyzer_newFromTokens(SymbolTable* st, Ast* ast, LexicalAnalyzer* la, const TokenBuffer* tokens, Interner* interner, Diagnostics* diagnostics)
+{
+    assert(tokens->size > 0); // at least END_OF_FILE
+    SyntacticAnalyzer* sa = (SyntacticAnalyzer*) malloc(sizeof(SyntacticAnalyzer));
+    sa->symbolTable = st;
+    // No rule makes more nodes than it consumes tokens: the tree is built without reallocating
+    ast_reserve(ast, (uint32_t) tokens->size);
+    sa->ast = ast;
+    sa->lexicalAnalyzer = la;
+    sa->interner = interner;
+    sa->diagnostics = diagnostics;
+    _sa_initStacks(sa);
+    sa->declType = DataType_INT;
+    sa->lastErrorOffset = UINT32_MAX;
+    sa->tokens = tokens;
+    sa->tokenIndex = (size_t) -1; // before the first token
+    sa->tokenError = 0;
     _sa_advance(sa); // init first token
     return sa;
 }
 
 void syntactic_analyzer_destroy(SyntacticAnalyzer* self)
 {
+    free(self->recoveries);
+    free(self->chains);
+    free(self->lists);
+    free(self->values);
+    free(self->symbols);
     free(self);
 }
 
-// Forward declaration of non terminal symbols rules
-void _sa_proc_program(SyntacticAnalyzer* self);
-void _sa_proc_decl_list(SyntacticAnalyzer* self);
-void _sa_proc_body(SyntacticAnalyzer* self);
-void _sa_proc_decl(SyntacticAnalyzer* self);
-DataType _sa_proc_type(SyntacticAnalyzer* self);
-void _sa_proc_stmt_list(SyntacticAnalyzer* self);
-void _sa_proc_ident_list(SyntacticAnalyzer* self, DataType dt);
-void _sa_proc_stmt(SyntacticAnalyzer* self);
-void _sa_proc_assign_stmt(SyntacticAnalyzer* self);
-void _sa_proc_if_stmt(SyntacticAnalyzer* self);
-void _sa_proc_do_stmt(SyntacticAnalyzer* self);
-void _sa_proc_read_stmt(SyntacticAnalyzer* self);
-void _sa_proc_write_stmt(SyntacticAnalyzer* self);
-DataType _sa_proc_simple_expr(SyntacticAnalyzer* self);
-void _sa_proc_condition(SyntacticAnalyzer* self);
-void _sa_proc_if_stmt_i(SyntacticAnalyzer* self);
-void _sa_proc_do_suffix(SyntacticAnalyzer* self);
-void _sa_proc_writable(SyntacticAnalyzer* self);
-DataType _sa_proc_term(SyntacticAnalyzer* self);
-DataType _sa_proc_simple_expr_i(SyntacticAnalyzer* self);
-DataType _sa_proc_expression(SyntacticAnalyzer* self);
-DataType _sa_proc_factor_a(SyntacticAnalyzer* self);
-DataType _sa_proc_term_i(SyntacticAnalyzer* self);
-void _sa_proc_addop(SyntacticAnalyzer* self);
-DataType _sa_proc_expression_i(SyntacticAnalyzer* self);
-DataType _sa_proc_factor(SyntacticAnalyzer* self);
-void _sa_proc_mulop(SyntacticAnalyzer* self);
-void _sa_proc_constant(SyntacticAnalyzer* self);
+static inline SaValue* _sa_pushValue(SyntacticAnalyzer* self, AstIndex node, DataType dt)
+{
+    if (self->valueCount == self->valueCapacity)
+        self->values = (SaValue*) _sa_reserve(self->values, &self->valueCapacity, self->valueCount, 1, sizeof(SaValue));
+    SaValue* value = &self->values[self->valueCount++];
+    value->node = node;
+    value->dt = dt;
+    return value;
+}
 
-void syntactic_analyzer_start(SyntacticAnalyzer* self)
+SaValue* _sa_topValue(SyntacticAnalyzer* self)
 {
-    _sa_proc_program(self);
-    _sa_eat(self, TokenType_END_OF_FILE);
+    return &self->values[self->valueCount - 1];
 }
 
-void _sa_proc_program(SyntacticAnalyzer* self)
+static inline void _sa_pushList(SyntacticAnalyzer* self, AstIndex parent)
 {
-    _sa_eat(self, TokenType_CLASS);
-    _sa_eat(self, TokenType_ID);
-    // First(decl-list)
-    if (self->curToken.type == TokenType_INT ||
-        self->curToken.type == TokenType_STRING ||
-        self->curToken.type == TokenType_FLOAT)
-    {
-        _sa_proc_decl_list(self);
-    }
-    _sa_proc_body(self);
+    if (self->listCount == self->listCapacity)
+        self->lists = (SaList*) _sa_reserve(self->lists, &self->listCapacity, self->listCount, 1, sizeof(SaList));
+    self->lists[self->listCount].parent = parent;
+    self->lists[self->listCount].last = AST_NONE;
+    ++self->listCount;
 }
 
-void _sa_proc_decl_list(SyntacticAnalyzer* self)
+// Links child after the children of the innermost list so far
+static inline void _sa_link(SyntacticAnalyzer* self, AstIndex child)
 {
-    _sa_proc_decl(self);
-    _sa_eat(self, TokenType_SEMICOLON);
-    // First(decl)
-    while (self->curToken.type == TokenType_INT ||
-           self->curToken.type == TokenType_STRING ||
-           self->curToken.type == TokenType_FLOAT)
-    {
-        _sa_proc_decl(self);
-        _sa_eat(self, TokenType_SEMICOLON);
-    }
+    SaList* list = &self->lists[self->listCount - 1];
+    list->last = ast_addChild(self->ast, list->parent, list->last, child);
 }
 
-void _sa_proc_body(SyntacticAnalyzer* self)
+// Node of the variable named by curToken, which was declared as entry (NULL if not declared)
+AstIndex _ast_newVar(SyntacticAnalyzer* self, AstKind kind, const SymbolTableEntry* entry)
 {
-    _sa_eat(self, TokenType_OPEN_CUR);
-    _sa_proc_stmt_list(self);
-    _sa_eat(self, TokenType_CLOSE_CUR);
+    AstIndex index = ast_newNode(self->ast, kind, self->curToken.offset);
+    AstNode* node = &self->ast->nodes[index];
+    node->var.symbolId = self->curToken.symbolId;
+    node->var.decl = AST_NONE;
+    if (entry)
+    {
+        node->var.decl = entry->decl;
+        node->dtype = (uint8_t) entry->dtype;
+    }
+    return index;
 }
 
-void _sa_proc_decl(SyntacticAnalyzer* self)
+AstIndex _ast_newOperator(SyntacticAnalyzer* self, AstKind kind, TokenType op, uint32_t offset, DataType dt, AstIndex child)
 {
-    DataType dt = _sa_proc_type(self);
-    _sa_proc_ident_list(self, dt);
+    AstIndex index = ast_newNode(self->ast, kind, offset);
+    AstNode* node = &self->ast->nodes[index];
+    node->op = (uint8_t) op;
+    node->dtype = (uint8_t) dt;
+    node->child = child;
+    return index;
 }
 
-DataType _sa_proc_type(SyntacticAnalyzer* self)
+// Panic mode: skips the rest of a statement or declaration with an error. Stops after its
+// ';', or before the '}' closing the enclosing block, a statement keyword or, in
+// declarations, a type or '{'. Identifiers also appear inside expressions, so they are
+// not taken as the start of a statement. Blocks found on the way are skipped whole
+void _sa_synchronize(SyntacticAnalyzer* self, int inDeclarations)
 {
-    DataType dt;
-    if (self->curToken.type == TokenType_INT || 
-        self->curToken.type == TokenType_STRING ||
-        self->curToken.type == TokenType_FLOAT)
+    unsigned depth = 0; // of the blocks skipped
+    for (;;)
     {
         switch (self->curToken.type)
         {
-        case TokenType_INT:
-            dt = DataType_INT;
+        case TokenType_END_OF_FILE:
+            return;
+        case TokenType_SEMICOLON:
+            if (depth == 0)
+            {
+                _sa_advance(self);
+                return;
+            }
             break;
-        case TokenType_STRING:
-            dt = DataType_STRING;
+        case TokenType_OPEN_CUR:
+            if (depth == 0 && inDeclarations)
+                return;
+            ++depth;
+            break;
+        case TokenType_CLOSE_CUR:
+            if (depth == 0)
+                return;
+            --depth;
+            break;
+        case TokenType_IF:
+        case TokenType_DO:
+        case TokenType_READ:
+        case TokenType_WRITE:
+            if (depth == 0)
+                return;
             break;
+        case TokenType_INT:
+        case TokenType_STRING:
         case TokenType_FLOAT:
-            dt = DataType_FLOAT;
+            if (depth == 0 && inDeclarations)
+                return;
             break;
         default:
-            assert("Invalid DataType value" && 0);
             break;
         }
         _sa_advance(self);
     }
-    else
-    {
-        const char* expectedStr = "int, string or float";
-        _sa_showExpectedErrorAndExit(self, expectedStr);
-    }
-    return dt;
 }
 
-void _sa_proc_stmt_list(SyntacticAnalyzer* self)
+// A declaration or statement starts: an error in it resumes parsing after it
+static inline void _sa_enterUnit(SyntacticAnalyzer* self, int inDeclarations)
 {
-    _sa_proc_stmt(self);
-    _sa_eat(self, TokenType_SEMICOLON);
-    // First(stmt)
-    while (self->curToken.type == TokenType_ID ||
-           self->curToken.type == TokenType_IF ||
-           self->curToken.type == TokenType_DO ||
-           self->curToken.type == TokenType_READ ||
-           self->curToken.type == TokenType_WRITE)
-    {
-        _sa_proc_stmt(self);
-        _sa_eat(self, TokenType_SEMICOLON);
-    }
+    if (self->recoveryCount == self->recoveryCapacity)
+        self->recoveries = (SaRecovery*) _sa_reserve(self->recoveries, &self->recoveryCapacity, self->recoveryCount, 1, sizeof(SaRecovery));
+    SaRecovery* recovery = &self->recoveries[self->recoveryCount++];
+    recovery->valueCount = self->valueCount;
+    recovery->listCount = self->listCount;
+    recovery->chainCount = self->chainCount;
+    recovery->level = self->symbolTable->level;
+    recovery->inDeclarations = inDeclarations;
 }
 
-void _sem_insertTokenInSymbolTable(SyntacticAnalyzer* self, DataType dt)
+// After an error in the innermost declaration or statement: drops what was parsed of it,
+// up to its end on the parser stack. Units inside it that did not start yet, e.g. the
+// statements of an if expanded with it, are skipped whole
+void _sa_recover(SyntacticAnalyzer* self)
 {
-    if (self->curToken.type == TokenType_ID)
+    const SaRecovery* recovery = &self->recoveries[--self->recoveryCount];
+    unsigned depth = 0; // of the units skipped
+    for (;;)
     {
-        char* lex = self->curToken.lex;
-        SymbolTableKey* stLookupKey = symbol_table_createKey(lex);
-        SymbolTableEntry* curEntry = (SymbolTableEntry*) g_hash_table_lookup(self->symbolTable, stLookupKey);
-        if (curEntry != NULL)
-        {
-            _sem_showAlreadyDeclaredIdentifierAndExit(self, lex);
-        }
-        else
-        {
-            SymbolTableEntry* entry = symbol_table_createEntry(dt);
-            g_hash_table_insert(self->symbolTable, stLookupKey, entry);
-        }
-        _sa_advance(self); // TokenType_ID
-    }
-    else
-    {
-        const char* expectedStr = token_type_toUserString(TokenType_ID);
-        _sa_showExpectedErrorAndExit(self, expectedStr);
-    }
-}
-
-void _sa_proc_ident_list(SyntacticAnalyzer* self, DataType dt)
-{
-    _sem_insertTokenInSymbolTable(self, dt);
-    while (self->curToken.type == TokenType_COLON)
-    {
-        _sa_advance(self); // TokenType_COLON
-        _sem_insertTokenInSymbolTable(self, dt);
+        unsigned symbol = self->symbols[--self->symbolCount];
+        if (SA_IS_UNIT_START(symbol))
+            ++depth;
+        else if (SA_IS_UNIT_END(symbol) && depth-- == 0)
+            break;
     }
+    self->valueCount = recovery->valueCount;
+    self->listCount = recovery->listCount;
+    self->chainCount = recovery->chainCount;
+    // Scopes opened inside it
+    while (self->symbolTable->level > recovery->level)
+        symbol_table_exitScope(self->symbolTable);
+    _sa_synchronize(self, recovery->inDeclarations);
 }
 
-void _sa_proc_stmt(SyntacticAnalyzer* self)
+// Replaces rule, just popped, by the symbols of its alternative predicted by curToken
+static inline void _sa_expand(SyntacticAnalyzer* self, SaRule rule)
 {
-    // First(assign-stmt)
-    if (self->curToken.type == TokenType_ID)
-    {
-        _sa_proc_assign_stmt(self);
-    }
-    // First(if-stmt)
-    else if (self->curToken.type == TokenType_IF)
-    {
-        _sa_proc_if_stmt(self);
-    }
-    // First(do-stmt)
-    else if (self->curToken.type == TokenType_DO)
-    {
-        _sa_proc_do_stmt(self);
-    }
-    // First(read-stmt)
-    else if (self->curToken.type == TokenType_READ)
-    {
-        _sa_proc_read_stmt(self);
-    }
-    // First(write-stmt)
-    else if (self->curToken.type == TokenType_WRITE)
+    unsigned alternative = sa_ll1_predict[rule][self->curToken.type];
+    const SaLl1Production* production = &sa_ll1_productions[alternative];
+    unsigned length = production->length;
+    if (alternative == SA_LL1_NONE)
     {
-        _sa_proc_write_stmt(self);
+        alternative = sa_ll1_default[rule];
+        if (alternative == SA_LL1_NONE)
+            _sa_showExpectedError(self, sa_expected[rule]);
+        production = &sa_ll1_productions[alternative];
+        length = production->length;
     }
-    else
+    else if (length > 0 && sa_ll1_symbols[production->first + length - 1] < SA_LL1_RULE)
     {
-        const char* expectedStr = "identifier, if, do, read or write";
-        _sa_showExpectedErrorAndExit(self, expectedStr);
+        // Predicted by its first symbol, a terminal: curToken
+        _sa_advance(self);
+        --length;
     }
+    if (length == 0)
+        return; // lambda
+
+    if (self->symbolCount + length > self->symbolCapacity)
+        self->symbols = (uint16_t*) _sa_reserve(self->symbols, &self->symbolCapacity, self->symbolCount, length, sizeof(uint16_t));
+    memcpy(&self->symbols[self->symbolCount], &sa_ll1_symbols[production->first], length * sizeof(uint16_t));
+    self->symbolCount += length;
 }
 
-void _sa_proc_assign_stmt(SyntacticAnalyzer* self) // TODO
+void _sem_declare(SyntacticAnalyzer* self)
 {
-    DataType dt1;
-    if (self->curToken.type == TokenType_ID)
-    {
-        char* lex = self->curToken.lex;
-        SymbolTableKey* stLookupKey = symbol_table_createKey(lex);
-        SymbolTableEntry* curEntry = (SymbolTableEntry*) g_hash_table_lookup(self->symbolTable, stLookupKey);
-        if (curEntry != NULL)
-        {
-            dt1 = curEntry->dtype;
-        }
-        else
-        {
-            _sem_showUndeclaredIdentifierAndExit(self, lex);
-        }
-        _sa_advance(self); // TokenType_ID
-    }
-    else
-    {
-        const char* expectedStr = token_type_toUserString(TokenType_ID);
-        _sa_showExpectedErrorAndExit(self, expectedStr);
-    }
-
-    _sa_eat(self, TokenType_ASSIGN);
-    DataType dt2 = _sa_proc_simple_expr(self);
+    if (self->curToken.type != TokenType_ID)
+        return; // reported as the ID is eaten
 
-    if (dt1 != dt2)
+    uint32_t symbolId = self->curToken.symbolId;
+    SymbolTableEntry* curEntry = symbol_table_lookup(self->symbolTable, symbolId);
+    // Declarations of outer scopes can be shadowed
+    if (curEntry != NULL && curEntry->level == self->symbolTable->level)
     {
-        _sem_showMismatchedDataTypesAndExit(self, dt1, dt2);
+        _sem_showAlreadyDeclaredIdentifier(self, symbolId);
     }
-}
-
-void _sa_proc_if_stmt(SyntacticAnalyzer* self)
-{
-    _sa_eat(self, TokenType_IF);
-    _sa_eat(self, TokenType_OPEN_PAR);
-    _sa_proc_condition(self);
-    _sa_eat(self, TokenType_CLOSE_PAR);
-    _sa_eat(self, TokenType_OPEN_CUR);
-    _sa_proc_stmt_list(self);
-    _sa_eat(self, TokenType_CLOSE_CUR);
-    _sa_proc_if_stmt_i(self);
-}
-
-void _sa_proc_do_stmt(SyntacticAnalyzer* self)
-{
-    _sa_eat(self, TokenType_DO);
-    _sa_eat(self, TokenType_OPEN_CUR);
-    _sa_proc_stmt_list(self);
-    _sa_eat(self, TokenType_CLOSE_CUR);
-    _sa_proc_do_suffix(self);
-}
-
-void _sa_proc_read_stmt(SyntacticAnalyzer* self)
-{
-    _sa_eat(self, TokenType_READ);
-    _sa_eat(self, TokenType_OPEN_PAR);
-    _sa_eat(self, TokenType_ID);
-    _sa_eat(self, TokenType_CLOSE_PAR);
-}
-
-void _sa_proc_write_stmt(SyntacticAnalyzer* self)
-{
-    _sa_eat(self, TokenType_WRITE);
-    _sa_eat(self, TokenType_OPEN_PAR);
-    _sa_proc_writable(self);
-    _sa_eat(self, TokenType_CLOSE_PAR);
-}
-
-DataType _sa_proc_simple_expr(SyntacticAnalyzer* self)
-{
-    DataType dt1 = _sa_proc_term(self);
-    DataType dt2 = _sa_proc_simple_expr_i(self);
-
-    if ((int) dt2 != -1 && dt1 != dt2) // dt2 may be -1 if lambda
+    else
     {
-        _sem_showMismatchedDataTypesAndExit(self, dt1, dt2);
+        SymbolTableEntry* entry = symbol_table_insert(self->symbolTable, symbolId, self->declType);
+        AstIndex decl = _ast_newVar(self, AstKind_DECL, entry);
+        self->ast->nodes[decl].var.decl = decl;
+        entry->decl = decl;
+        _sa_link(self, decl);
     }
-
-    return dt1;
 }
 
-void _sa_proc_condition(SyntacticAnalyzer* self)
+// Variable named by curToken, which must have been declared
+SymbolTableEntry* _sem_lookupDeclared(SyntacticAnalyzer* self)
 {
-    _sa_proc_expression(self);
+    uint32_t symbolId = self->curToken.symbolId;
+    SymbolTableEntry* entry = symbol_table_lookup(self->symbolTable, symbolId);
+    if (entry == NULL)
+        _sem_showUndeclaredIdentifier(self, symbolId);
+    return entry;
 }
 
-void _sa_proc_if_stmt_i(SyntacticAnalyzer* self)
+// Node of the constant curToken
+AstIndex _ast_newConstant(SyntacticAnalyzer* self, DataType* dt)
 {
-    if (self->curToken.type == TokenType_ELSE)
+    AstIndex index = ast_newNode(self->ast, AstKind_CONSTANT, self->curToken.offset);
+    AstNode* constant = &self->ast->nodes[index];
+    switch (self->curToken.type)
     {
-        _sa_advance(self);
-        _sa_eat(self, TokenType_OPEN_CUR);
-        _sa_proc_stmt_list(self);
-        _sa_eat(self, TokenType_CLOSE_CUR);
+    case TokenType_INTEGER:
+        *dt = DataType_INT;
+        constant->intVal = self->curToken.longVal;
+        break;
+    case TokenType_LITERAL:
+        *dt = DataType_STRING;
+        constant->literalId = self->curToken.literalId;
+        break;
+    case TokenType_REAL:
+        *dt = DataType_FLOAT;
+        constant->realVal = self->curToken.doubleVal;
+        break;
+    default:
+        assert("Invalid DataType value" && 0);
+        break;
     }
+    constant->dtype = (uint8_t) *dt;
+    return index;
 }
 
-void _sa_proc_do_suffix(SyntacticAnalyzer* self)
-{
-    _sa_eat(self, TokenType_WHILE);
-    _sa_eat(self, TokenType_OPEN_PAR);
-    _sa_proc_condition(self);
-    _sa_eat(self, TokenType_CLOSE_PAR);
-}
-
-void _sa_proc_writable(SyntacticAnalyzer* self)
+void _sa_endAssign(SyntacticAnalyzer* self)
 {
-    _sa_proc_simple_expr(self);
+    SaValue value = self->values[--self->valueCount];
+    SaValue* assign = _sa_topValue(self);
+    self->ast->nodes[assign->node].child = value.node;
+    if (assign->dt != value.dt)
+        _sem_showMismatchedDataTypes(self, assign->dt, value.dt);
 }
 
-DataType _sa_proc_term(SyntacticAnalyzer* self)
+// Applies the operator waiting in chain to its right operand
+void _sa_applyChain(SyntacticAnalyzer* self, SaChain* chain, AstIndex right, DataType dt)
 {
-    DataType dt1 = _sa_proc_factor_a(self);
-    TokenType tt = self->curToken.type;
-    DataType dt2 = _sa_proc_term_i(self);
+    if (!(sa_operators[chain->op].binaryTypes & SA_TYPE_BIT(dt)))
+        _sem_showInvalidOperator(self, dt, chain->op);
 
-    if ((int) dt2 != -1 && dt1 != dt2) // dt2 may return -1 if lambda
+    if (dt != chain->lastDt)
     {
-        _sem_showMismatchedDataTypesAndExit(self, dt1, dt2);
+        chain->hasMismatch = 1;
+        chain->mismatch[0] = chain->lastDt;
+        chain->mismatch[1] = dt;
     }
-    
-    if (tt == TokenType_DIV)
-        return DataType_FLOAT;
+    chain->lastDt = dt;
 
-    return dt1;
+    if (constant_folding_binary(self->ast, chain->node, chain->node, chain->op, right, chain->dtype, self->interner))
+        return;
+    chain->node = _ast_newOperator(self, AstKind_BINARY, chain->op, chain->opOffset, chain->dtype, chain->node);
+    self->ast->nodes[self->ast->nodes[chain->node].child].sibling = right;
 }
 
-DataType _sa_proc_simple_expr_i(SyntacticAnalyzer* self)
+// Closes the chains above base of higher precedence than precedence, innermost first: node
+// is the last operand of each, and then the chain itself. Operands of a chain must all have
+// the same type: as it ends, the last pair that differs is reported
+DataType _sa_closeChains(SyntacticAnalyzer* self, uint32_t base, unsigned precedence, AstIndex* node, DataType dt)
 {
-    DataType dt = -1;
-    // First(addop)
-    if (self->curToken.type == TokenType_ADD ||
-        self->curToken.type == TokenType_SUB ||
-        self->curToken.type == TokenType_OR)
+    while (self->chainCount > base && self->chains[self->chainCount - 1].precedence > precedence)
     {
-        TokenType tt1 = self->curToken.type;
-        _sa_proc_addop(self);
-        DataType dt1 = _sa_proc_term(self);
-
-        if (dt1 == DataType_STRING && tt1 != TokenType_ADD)
-            _sem_showInvalidOperatorAndExit(self, dt1, tt1);
-
-        DataType dt2 = _sa_proc_simple_expr_i(self);
-
-        if ((int) dt2 != -1 && dt1 != dt2) // dt2 may return -1 if lamda
-        {
-            _sem_showMismatchedDataTypesAndExit(self, dt1, dt2);
-        }
-            
-        dt = dt1;
+        SaChain* chain = &self->chains[--self->chainCount];
+        _sa_applyChain(self, chain, *node, dt);
+        if (chain->hasMismatch)
+            _sem_showMismatchedDataTypes(self, chain->mismatch[0], chain->mismatch[1]);
+        *node = chain->node;
+        dt = chain->dtype;
     }
     return dt;
 }
 
-DataType _sa_proc_expression(SyntacticAnalyzer* self)
-{
-    DataType dt1 = _sa_proc_simple_expr(self);
-    DataType dt2 = _sa_proc_expression_i(self);
-
-    if ((int) dt2 != -1 && dt1 != dt2) // dt2 may return -1 if lamda
-    {
-        _sem_showMismatchedDataTypesAndExit(self, dt1, dt2);
-    }
-
-    if ((int) dt2 != -1) // has Relop
-        return DataType_BOOLEAN;
-
-    return dt1;
-}
-
-DataType _sa_proc_factor_a(SyntacticAnalyzer* self)
+// Pushes op, waiting for its operand, on the chains
+SaChain* _sa_pushChain(SyntacticAnalyzer* self, TokenType op)
 {
-    DataType dt;
-    if (self->curToken.type == TokenType_NOT)
-    {
-        _sa_advance(self);
-        dt = _sa_proc_factor(self);
-        if (dt != DataType_BOOLEAN)
-            _sem_showInvalidOperatorAndExit(self, dt, TokenType_NOT);
-    }
-    else if (self->curToken.type == TokenType_SUB)
-    {
-        _sa_advance(self);
-        dt = _sa_proc_factor(self);
-        if (dt != DataType_INT &&
-            dt != DataType_FLOAT)
-            _sem_showInvalidOperatorAndExit(self, dt, TokenType_SUB);
-    }
-    else
-    {
-        dt = _sa_proc_factor(self);
-    }
-    return dt;
+    if (self->chainCount == self->chainCapacity)
+        self->chains = (SaChain*) _sa_reserve(self->chains, &self->chainCapacity, self->chainCount, 1, sizeof(SaChain));
+    SaChain* chain = &self->chains[self->chainCount++];
+    chain->op = op;
+    chain->opOffset = self->curToken.offset;
+    chain->precedence = SA_PRECEDENCE_NONE;
+    return chain;
 }
 
-DataType _sa_proc_term_i(SyntacticAnalyzer* self)
+// expression, or simple-expr if minPrecedence is SA_PRECEDENCE_ADDITIVE, pushed on the
+// values. Precedence climbing on the chains, as an operator stack: the chain of each
+// precedence stays open while operators of higher precedence build its next operand. An
+// operator of lower precedence, or the end of the expression, closes them, and the operand
+// they built is the right one of the chain below. Prefix operators and parentheses wait
+// on the stack for their operand, so nesting grows it and not the C one
+void _sa_expression(SyntacticAnalyzer* self, unsigned minPrecedence)
 {
-    DataType dt = -1;
-    // First(mulop)
-    if (self->curToken.type == TokenType_MUL ||
-        self->curToken.type == TokenType_DIV ||
-        self->curToken.type == TokenType_AND)
+    uint32_t base = self->chainCount;
+    unsigned parentheses = 0; // open ones, inside which expressions take relational operators
+    AstIndex node = AST_NONE;
+    DataType dt = DataType_INT;
+    for (;;)
     {
+        // factor-a: a factor, after a single prefix operator or not
         TokenType tt = self->curToken.type;
-        _sa_proc_mulop(self);
-        DataType dt1 = _sa_proc_factor_a(self);
-
-        if ((tt == TokenType_AND && dt1 != DataType_BOOLEAN)
-            || ((tt == TokenType_MUL || tt == TokenType_DIV) && (dt1 != DataType_INT && dt1 != DataType_FLOAT)))
+        if (sa_operators[tt].unaryTypes)
         {
-            _sem_showInvalidOperatorAndExit(self, dt1, tt);
+            _sa_pushChain(self, tt);
+            _sa_advance(self);
+            tt = self->curToken.type;
+        }
+        if (tt == TokenType_OPEN_PAR)
+        {
+            _sa_pushChain(self, tt);
+            ++parentheses;
+            _sa_advance(self);
+            continue;
+        }
+        if (tt == TokenType_ID)
+        {
+            SymbolTableEntry* entry = _sem_lookupDeclared(self);
+            dt = entry->dtype;
+            node = _ast_newVar(self, AstKind_ID, entry);
+        }
+        else if (tt == TokenType_INTEGER || tt == TokenType_LITERAL || tt == TokenType_REAL)
+        {
+            node = _ast_newConstant(self, &dt);
+        }
+        else
+        {
+            _sa_showExpectedError(self, "identifier, integer const, literal, real const or (");
         }
-
-
-        DataType dt2 = _sa_proc_term_i(self);
-
-        if ((int) dt2 != -1 && dt1 != dt2) // dt2 may return -1 if lambda
-            _sem_showMismatchedDataTypesAndExit(self, dt1, dt2);
-
-        dt = dt1;
-    }
-    return dt;
-}
-
-void _sa_proc_addop(SyntacticAnalyzer* self)
-{
-    // First(addop)
-    if (self->curToken.type == TokenType_ADD ||
-        self->curToken.type == TokenType_SUB ||
-        self->curToken.type == TokenType_OR)
-    {
         _sa_advance(self);
-    }
-    else
-    {
-        const char* expectedStr = "+, - or ||";
-        _sa_showExpectedErrorAndExit(self, expectedStr);
-    }
-}
 
-DataType _sa_proc_expression_i(SyntacticAnalyzer* self)
-{
-    DataType dt = -1;
-    // First(relop)
-    if (self->curToken.type == TokenType_LOWER ||
-        self->curToken.type == TokenType_LOWER_EQ ||
-        self->curToken.type == TokenType_GREATER ||
-        self->curToken.type == TokenType_GREATER_EQ ||
-        self->curToken.type == TokenType_NOT_EQUALS ||
-        self->curToken.type == TokenType_EQUALS)
-    {
-        TokenType tt = self->curToken.type;
-        _sa_advance(self);
-        dt = _sa_proc_simple_expr(self);
-        switch (dt)
+        // node is an operand: of the prefix operator waiting for it, if any, then of the
+        // operator curToken, or of the chains it ends
+        for (;;)
         {
-        case DataType_INT:
-        case DataType_FLOAT:
-            // Int e float aceitam todas as comparacoes
-            break;
-        case DataType_STRING:
-            if (tt != TokenType_NOT_EQUALS &&
-                tt != TokenType_EQUALS)
+            SaChain* top = self->chainCount > base ? &self->chains[self->chainCount - 1] : NULL;
+            if (top && top->precedence == SA_PRECEDENCE_NONE && top->op != TokenType_OPEN_PAR)
             {
-                _sem_showInvalidOperatorAndExit(self, dt, tt);
+                if (!(sa_operators[top->op].unaryTypes & SA_TYPE_BIT(dt)))
+                    _sem_showInvalidOperator(self, dt, top->op);
+                if (!constant_folding_unary(self->ast, node, top->op, node))
+                    node = _ast_newOperator(self, AstKind_UNARY, top->op, top->opOffset, dt, node);
+                --self->chainCount;
+                top = self->chainCount > base ? top - 1 : NULL;
             }
-            break;
-        default:
-            assert("Invalid DataType value" && 0);
-            break;
+
+            tt = self->curToken.type;
+            const SaOperator* op = &sa_operators[tt];
+            unsigned precedence = op->precedence;
+            if (precedence < (parentheses > 0 ? SA_PRECEDENCE_RELATIONAL : minPrecedence))
+                precedence = SA_PRECEDENCE_NONE;
+            if (top && top->precedence > precedence)
+            {
+                dt = _sa_closeChains(self, base, precedence, &node, dt);
+                top = self->chainCount > base ? &self->chains[self->chainCount - 1] : NULL;
+            }
+            int isOpen = top && top->precedence == precedence;
+            if (isOpen && op->associativity == SA_ASSOCIATIVITY_NONE)
+            {
+                // Ends the expression, which takes a single operator of its precedence
+                precedence = SA_PRECEDENCE_NONE;
+                dt = _sa_closeChains(self, base, precedence, &node, dt);
+            }
+
+            if (precedence != SA_PRECEDENCE_NONE)
+            {
+                if (isOpen)
+                {
+                    _sa_applyChain(self, top, node, dt);
+                }
+                else
+                {
+                    top = _sa_pushChain(self, tt);
+                    top->node = node;
+                    top->precedence = (uint8_t) precedence;
+                    top->dtype = op->resultType == SA_OPERAND_TYPE ? dt : (DataType) op->resultType;
+                    top->lastDt = dt;
+                    top->hasMismatch = 0;
+                }
+                top->op = tt;
+                top->opOffset = self->curToken.offset;
+                _sa_advance(self);
+                break; // to its right operand
+            }
+            if (parentheses == 0)
+            {
+                _sa_pushValue(self, node, dt);
+                return;
+            }
+            _sa_eat(self, TokenType_CLOSE_PAR);
+            --self->chainCount;
+            --parentheses;
         }
     }
-    return dt;
 }
 
-DataType _sa_proc_factor(SyntacticAnalyzer* self)
-{
-    DataType dt;
-    if (self->curToken.type == TokenType_ID)
-    {
-        char* lex = self->curToken.lex;
-        SymbolTableKey* stLookupKey = symbol_table_createKey(lex);
-        SymbolTableEntry* stEntry = g_hash_table_lookup(self->symbolTable, stLookupKey);
-        if (stEntry == NULL)
+// Runs action, just popped, with curToken the token after it
+static inline void _sa_act(SyntacticAnalyzer* self, SaAction action)
+{
+    switch (action)
+    {
+    case SaAction_PROGRAM:
+        _sa_pushList(self, ast_newNode(self->ast, AstKind_PROGRAM, self->curToken.offset));
+        break;
+    case SaAction_PROGRAM_NAME:
+        if (self->curToken.type == TokenType_ID)
+            self->ast->nodes[self->lists[0].parent].var.symbolId = self->curToken.symbolId;
+        break;
+    case SaAction_DECL_UNIT:
+        _sa_enterUnit(self, 1);
+        break;
+    case SaAction_STMT_UNIT:
+        _sa_enterUnit(self, 0);
+        break;
+    case SaAction_DECL_END:
+        --self->recoveryCount; // parsed without errors
+        break;
+    case SaAction_STMT_END:
+        --self->recoveryCount;
+        _sa_link(self, self->values[--self->valueCount].node);
+        break;
+    case SaAction_DECLARATIONS:
+        ALLOC_STATS_PHASE(AllocPhase_DECLARATIONS);
+        break;
+    case SaAction_STATEMENTS:
+        ALLOC_STATS_PHASE(AllocPhase_STATEMENTS);
+        break;
+    case SaAction_CHILD:
+        _sa_link(self, self->values[--self->valueCount].node);
+        break;
+    case SaAction_DECL_TYPE:
+        if (self->curToken.type == TokenType_INT)
+            self->declType = DataType_INT;
+        else if (self->curToken.type == TokenType_STRING)
+            self->declType = DataType_STRING;
+        else if (self->curToken.type == TokenType_FLOAT)
+            self->declType = DataType_FLOAT;
+        break;
+    case SaAction_DECLARE:
+        _sem_declare(self);
+        break;
+    case SaAction_BLOCK:
+    case SaAction_IF:
+    case SaAction_DO:
+    case SaAction_WRITE:
+    {
+        static const AstKind kinds[SaAction_SIZE] =
         {
-            _sem_showUndeclaredIdentifierAndExit(self, lex);
-        }
-        dt = stEntry->dtype;
-        _sa_advance(self);
-    }
-    // First(constant)
-    else if (self->curToken.type == TokenType_INTEGER ||
-             self->curToken.type == TokenType_LITERAL ||
-             self->curToken.type == TokenType_REAL)
-    {
-        switch (self->curToken.type)
+            [SaAction_BLOCK] = AstKind_BLOCK,
+            [SaAction_IF] = AstKind_IF,
+            [SaAction_DO] = AstKind_DO,
+            [SaAction_WRITE] = AstKind_WRITE,
+        };
+        _sa_pushList(self, ast_newNode(self->ast, kinds[action], self->curToken.offset));
+        break;
+    }
+    case SaAction_END:
+        _sa_pushValue(self, self->lists[--self->listCount].parent, DataType_INT);
+        break;
+    case SaAction_SCOPE_BLOCK:
+        _sa_pushList(self, ast_newNode(self->ast, AstKind_BLOCK, self->curToken.offset));
+        symbol_table_enterScope(self->symbolTable);
+        break;
+    case SaAction_SCOPE_END:
+        symbol_table_exitScope(self->symbolTable);
+        --self->listCount;
+        _sa_link(self, self->lists[self->listCount].parent);
+        break;
+    case SaAction_ASSIGN:
+    {
+        SymbolTableEntry* entry = _sem_lookupDeclared(self);
+        _sa_pushValue(self, _ast_newVar(self, AstKind_ASSIGN, entry), entry->dtype);
+        break;
+    }
+    case SaAction_ASSIGN_VALUE:
+        _sa_expression(self, SA_PRECEDENCE_ADDITIVE);
+        _sa_endAssign(self);
+        break;
+    case SaAction_READ:
+        _sa_pushValue(self, AST_NONE, DataType_INT)->offset = self->curToken.offset;
+        break;
+    case SaAction_READ_VAR:
+        if (self->curToken.type == TokenType_ID)
         {
-        case TokenType_INTEGER:
-            dt = DataType_INT;
-            break;
-        case TokenType_LITERAL:
-            dt = DataType_STRING;
-            break;
-        case TokenType_REAL:
-            dt = DataType_FLOAT;
-            break;
-        default:
-            assert("Invalid DataType value" && 0);
-            break;
+            SaValue* read = _sa_topValue(self);
+            read->node = _ast_newVar(self, AstKind_READ, symbol_table_lookup(self->symbolTable, self->curToken.symbolId));
+            self->ast->nodes[read->node].offset = read->offset;
         }
-        _sa_proc_constant(self);
-    }
-    else if (self->curToken.type == TokenType_OPEN_PAR)
-    {
-        _sa_advance(self);
-        dt = _sa_proc_expression(self);
-        _sa_eat(self, TokenType_CLOSE_PAR);
-    }
-    else
-    {
-        const char* expectedStr = "identifier, integer const, literal, real const or (";
-        _sa_showExpectedErrorAndExit(self, expectedStr);
+        break;
+    case SaAction_CONDITION:
+        _sa_expression(self, SA_PRECEDENCE_RELATIONAL);
+        _sa_link(self, self->values[--self->valueCount].node);
+        break;
+    case SaAction_WRITABLE:
+        _sa_expression(self, SA_PRECEDENCE_ADDITIVE);
+        _sa_link(self, self->values[--self->valueCount].node);
+        break;
+    default:
+        assert("Invalid SaAction value" && 0);
+        break;
+    }
+}
+
+// Table driven LL(1): pops the symbols off the parser stack until it is empty. Rules are
+// expanded, terminals eaten and actions run. Nesting only grows the stacks, not the C one
+void _sa_parse(SyntacticAnalyzer* self)
+{
+    while (self->symbolCount > 0)
+    {
+        unsigned symbol = self->symbols[--self->symbolCount];
+        if (symbol == self->curToken.type)
+            _sa_advance(self);
+        else if (symbol < SA_LL1_RULE)
+            _sa_eat(self, (TokenType) symbol); // reports the error
+        else if (symbol < SA_LL1_ACTION)
+            _sa_expand(self, (SaRule) (symbol - SA_LL1_RULE));
+        else
+            _sa_act(self, (SaAction) (symbol - SA_LL1_ACTION));
     }
-    return dt;
 }
 
-void _sa_proc_mulop(SyntacticAnalyzer* self)
+void syntactic_analyzer_start(SyntacticAnalyzer* self)
 {
-    // First(mulop)
-    if  (self->curToken.type == TokenType_MUL ||
-         self->curToken.type == TokenType_DIV ||
-         self->curToken.type == TokenType_AND)
-    {
-        _sa_advance(self);
-    }
-    else
-    {
-        const char* expectedStr = "*, / or &&";
-        _sa_showExpectedErrorAndExit(self, expectedStr);
-    }
+    self->symbols[self->symbolCount++] = SA_LL1_RULE | SaRule_PROGRAM;
+    // Errors in a declaration or statement jump back here, to resume after it
+    if (setjmp(self->recoveryEnv) != 0)
+        _sa_recover(self);
+    _sa_parse(self);
 }
-
-void _sa_proc_constant(SyntacticAnalyzer* self)
-{
-    if (self->curToken.type == TokenType_INTEGER ||
-        self->curToken.type == TokenType_LITERAL ||
-        self->curToken.type == TokenType_REAL)
-    {
-        _sa_advance(self);
-    }
-    else
-    {
-        const char* expectedStr = "integer const, literal or real const";
-        _sa_showExpectedErrorAndExit(self, expectedStr);
-    }
-}
\ No newline at end of file
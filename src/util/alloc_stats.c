@@ -0,0 +1,86 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "util/alloc_stats.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct AllocCounts
+{
+    size_t heap;
+    size_t arena;
+} AllocCounts;
+
+// Lexer threads allocate too, so counts are updated atomically
+static AllocCounts as_counts[AllocPhase_SIZE];
+static AllocPhase as_phase = AllocPhase_SETUP;
+
+static const char* as_phaseNames[AllocPhase_SIZE] =
+{
+    [AllocPhase_SETUP] = "setup",
+    [AllocPhase_TOKENIZE] = "tokenize",
+    [AllocPhase_DECLARATIONS] = "declarations",
+    [AllocPhase_STATEMENTS] = "statements",
+    [AllocPhase_CODE_GENERATION] = "code generation",
+    [AllocPhase_TEARDOWN] = "teardown",
+};
+
+void _as_print(void)
+{
+    for (int phase = 0; phase < AllocPhase_SIZE; ++phase)
+    {
+        fprintf(stderr, "Allocations in %s: %zu heap, %zu arena\n", as_phaseNames[phase], as_counts[phase].heap, as_counts[phase].arena);
+    }
+}
+
+void alloc_stats_start(void)
+{
+    atexit(_as_print);
+}
+
+void alloc_stats_setPhase(AllocPhase phase)
+{
+    as_phase = phase;
+}
+
+void alloc_stats_countArena(void)
+{
+    __atomic_fetch_add(&as_counts[as_phase].arena, 1, __ATOMIC_RELAXED);
+}
+
+#ifdef ALLOC_STATS
+
+// Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc: calls to them from the
+// compiler objects reach these, and __real_* are the libc functions
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size)
+{
+    __atomic_fetch_add(&as_counts[as_phase].heap, 1, __ATOMIC_RELAXED);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    __atomic_fetch_add(&as_counts[as_phase].heap, 1, __ATOMIC_RELAXED);
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    __atomic_fetch_add(&as_counts[as_phase].heap, 1, __ATOMIC_RELAXED);
+    return __real_realloc(ptr, size);
+}
+
+#endif // ALLOC_STATS
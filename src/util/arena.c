@@ -0,0 +1,130 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "util/arena.h"
+
+#include "debug.h"
+#include "util/alloc_stats.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_BLOCK_SIZE 65536
+#define ARENA_ALIGNMENT _Alignof(max_align_t)
+
+typedef struct ArenaBlock
+{
+    struct ArenaBlock* next;
+    max_align_t data[]; // aligned start
+} ArenaBlock;
+
+struct Arena
+{
+    ArenaBlock* blocks; // the current one first
+    char* cur;
+    char* end;
+#ifdef DEBUG
+    size_t allocatedBytes[ArenaTag_SIZE];
+#endif
+};
+
+Arena* arena_new(void)
+{
+    Arena* arena = (Arena*) malloc(sizeof(Arena));
+    arena->blocks = NULL;
+    arena->cur = NULL;
+    arena->end = NULL;
+#ifdef DEBUG
+    memset(arena->allocatedBytes, 0, sizeof(arena->allocatedBytes));
+#endif
+    return arena;
+}
+
+void arena_destroy(Arena* self)
+{
+#ifdef DEBUG
+    static const char* tagNames[ArenaTag_SIZE] = {"interner"};
+    for (int tag = 0; tag < ArenaTag_SIZE; ++tag)
+        DEBUG_PRINT("Arena: %zu bytes for %s.\n", self->allocatedBytes[tag], tagNames[tag]);
+#endif
+
+    ArenaBlock* block = self->blocks;
+    while (block)
+    {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(self);
+}
+
+// Opens a block with room for at least size bytes. Big allocations get a block of their
+// own, placed after the current one so its free space is not lost
+char* _ar_newBlock(Arena* self, size_t size)
+{
+    size_t dataSize = size > ARENA_BLOCK_SIZE / 4 ? size : ARENA_BLOCK_SIZE;
+    ArenaBlock* block = (ArenaBlock*) malloc(sizeof(ArenaBlock) + dataSize);
+    char* data = (char*) block->data;
+    if (dataSize != ARENA_BLOCK_SIZE && self->blocks)
+    {
+        block->next = self->blocks->next;
+        self->blocks->next = block;
+        return data;
+    }
+
+    block->next = self->blocks;
+    self->blocks = block;
+    self->cur = data + size;
+    self->end = data + dataSize;
+    return data;
+}
+
+void* arena_alloc(Arena* self, size_t size, ArenaTag tag)
+{
+    ALLOC_STATS_COUNT_ARENA();
+#ifdef DEBUG
+    self->allocatedBytes[tag] += size;
+#else
+    (void) tag;
+#endif
+
+    size_t padding = (ARENA_ALIGNMENT - (uintptr_t) self->cur % ARENA_ALIGNMENT) % ARENA_ALIGNMENT;
+    if ((size_t) (self->end - self->cur) < padding + size)
+        return _ar_newBlock(self, size);
+
+    char* p = self->cur + padding;
+    self->cur = p + size;
+    return p;
+}
+
+char* arena_allocString(Arena* self, const char* str, size_t length, ArenaTag tag)
+{
+    ALLOC_STATS_COUNT_ARENA();
+#ifdef DEBUG
+    self->allocatedBytes[tag] += length + 1;
+#else
+    (void) tag;
+#endif
+
+    char* p;
+    if ((size_t) (self->end - self->cur) < length + 1)
+    {
+        p = _ar_newBlock(self, length + 1);
+    }
+    else
+    {
+        p = self->cur;
+        self->cur += length + 1;
+    }
+    memcpy(p, str, length);
+    p[length] = '\0';
+    return p;
+}
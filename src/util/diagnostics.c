@@ -0,0 +1,96 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "util/diagnostics.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define DIAGNOSTICS_INITIAL_CAPACITY 256
+#define DIAGNOSTICS_MESSAGE_SIZE 256
+
+Diagnostics* diagnostics_new(unsigned maxErrors)
+{
+    Diagnostics* diag = (Diagnostics*) malloc(sizeof(Diagnostics));
+    dstring_init(&diag->text, DIAGNOSTICS_INITIAL_CAPACITY);
+    diag->count = 0;
+    diag->maxErrors = maxErrors;
+    return diag;
+}
+
+void diagnostics_destroy(Diagnostics* self)
+{
+    dstring_free(&self->text);
+    free(self);
+}
+
+void _dg_append(Diagnostics* self, const char* format, va_list args)
+{
+    char buffer[DIAGNOSTICS_MESSAGE_SIZE];
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int length = vsnprintf(buffer, DIAGNOSTICS_MESSAGE_SIZE, format, args);
+    if (length >= DIAGNOSTICS_MESSAGE_SIZE)
+    {
+        // Long lexemes
+        char* message = (char*) malloc((size_t) length + 1);
+        vsnprintf(message, (size_t) length + 1, format, argsCopy);
+        dstring_appendN(&self->text, message, (unsigned) length);
+        free(message);
+    }
+    else if (length > 0)
+    {
+        dstring_appendN(&self->text, buffer, (unsigned) length);
+    }
+    va_end(argsCopy);
+}
+
+void _dg_appendf(Diagnostics* self, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    _dg_append(self, format, args);
+    va_end(args);
+}
+
+void diagnostics_report(Diagnostics* self, unsigned line, unsigned column, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    diagnostics_reportV(self, line, column, format, args);
+    va_end(args);
+}
+
+void diagnostics_reportV(Diagnostics* self, unsigned line, unsigned column, const char* format, va_list args)
+{
+    _dg_appendf(self, "Error at line %u column %u: ", line, column);
+    _dg_append(self, format, args);
+
+    ++self->count;
+    if (self->count >= self->maxErrors)
+        diagnostics_exit(self);
+}
+
+unsigned diagnostics_count(const Diagnostics* self)
+{
+    return self->count;
+}
+
+void diagnostics_flush(Diagnostics* self)
+{
+    fputs(self->text.str, stderr);
+    dstring_clear(&self->text);
+}
+
+void diagnostics_exit(Diagnostics* self)
+{
+    diagnostics_flush(self);
+    exit(-1);
+}
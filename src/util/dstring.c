@@ -11,21 +11,31 @@
 #include "util/dstring.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #define DSTRING_GROWTH_FACTOR 2
 
 void dstring_init(DString* dstring, unsigned initialCapacity)
 {
     // capacity and length does not consider '\0', only 'useful' chars
-    dstring->capacity = initialCapacity;
+    if (initialCapacity <= DSTRING_SMALL_CAPACITY)
+    {
+        dstring->capacity = DSTRING_SMALL_CAPACITY;
+        dstring->str = dstring->small;
+    }
+    else
+    {
+        dstring->capacity = initialCapacity;
+        dstring->str = (char*) malloc((dstring->capacity + 1) * sizeof(char));
+    }
     dstring->length = 0;
-    dstring->str = (char*) malloc((dstring->capacity + 1) * sizeof(char));
     dstring->str[0] = '\0';
 }
 
 void dstring_free(DString* dstring)
 {
-    free(dstring->str);
+    if (dstring->str != dstring->small)
+        free(dstring->str);
 }
 
 void dstring_clear(DString* dstring)
@@ -34,12 +44,30 @@ void dstring_clear(DString* dstring)
     dstring->length = 0;
 }
 
+// Makes room for at least capacity chars
+void _ds_reserve(DString* dstring, unsigned capacity)
+{
+    unsigned newCapacity = dstring->capacity * DSTRING_GROWTH_FACTOR;
+    if (newCapacity < capacity)
+        newCapacity = capacity;
+
+    if (dstring->str == dstring->small)
+    {
+        dstring->str = (char*) malloc((newCapacity + 1) * sizeof(char));
+        memcpy(dstring->str, dstring->small, dstring->length + 1);
+    }
+    else
+    {
+        dstring->str = (char*) realloc(dstring->str, (newCapacity + 1) * sizeof(char));
+    }
+    dstring->capacity = newCapacity;
+}
+
 void dstring_appendChar(DString* dstring, char c)
 {
     if (dstring->length == dstring->capacity)
     {
-        dstring->capacity *= DSTRING_GROWTH_FACTOR;
-        dstring->str = (char*) realloc(dstring->str, (dstring->capacity + 1) * sizeof(char));
+        _ds_reserve(dstring, dstring->length + 1);
     }
 
     dstring->str[dstring->length] = c;
@@ -47,15 +75,49 @@ void dstring_appendChar(DString* dstring, char c)
     dstring->str[dstring->length] = '\0';
 }
 
+void dstring_appendN(DString* dstring, const char* str, unsigned length)
+{
+    if (dstring->capacity - dstring->length < length)
+    {
+        _ds_reserve(dstring, dstring->length + length);
+    }
+
+    memcpy(dstring->str + dstring->length, str, length);
+    dstring->length += length;
+    dstring->str[dstring->length] = '\0';
+}
+
 void dstring_shrinkToFit(DString* dstring)
 {
-    dstring->capacity = dstring->length;
-    dstring->str = (char*) realloc(dstring->str, (dstring->capacity + 1) * sizeof(char));
+    if (dstring->str == dstring->small)
+        return;
+
+    if (dstring->length <= DSTRING_SMALL_CAPACITY)
+    {
+        memcpy(dstring->small, dstring->str, dstring->length + 1);
+        free(dstring->str);
+        dstring->str = dstring->small;
+        dstring->capacity = DSTRING_SMALL_CAPACITY;
+    }
+    else
+    {
+        dstring->capacity = dstring->length;
+        dstring->str = (char*) realloc(dstring->str, (dstring->capacity + 1) * sizeof(char));
+    }
 }
 
-char* dstring_steal(DString* dstring, unsigned newCapacity)
+char* dstring_steal(DString* dstring)
 {
-    char* str = dstring->str;
-    dstring_init(dstring, newCapacity);
+    char* str;
+    if (dstring->str == dstring->small)
+    {
+        str = (char*) malloc((dstring->length + 1) * sizeof(char));
+        memcpy(str, dstring->small, dstring->length + 1);
+    }
+    else
+    {
+        str = dstring->str;
+    }
+    dstring_init(dstring, 0);
     return str;
 }
@@ -0,0 +1,138 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+#include "util/interner.h"
+
+#include "util/arena.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INTERNER_INITIAL_SLOTS 1024 // power of 2
+#define INTERNER_INITIAL_ENTRIES 512
+
+typedef struct InternerEntry
+{
+    const char* str;
+    unsigned length;
+    uint32_t hash;
+} InternerEntry;
+
+struct Interner
+{
+    // Open addressing table of id + 1 (0 = empty slot), linear probing
+    uint32_t* slots;
+    uint32_t slotMask;
+
+    InternerEntry* entries; // indexed by id
+    uint32_t size;
+    uint32_t capacity;
+
+    Arena* arena; // strings
+};
+
+// FNV-1a
+uint32_t _in_hash(const char* str, unsigned length)
+{
+    uint32_t hash = 2166136261u;
+    for (unsigned i = 0; i < length; ++i)
+    {
+        hash ^= (unsigned char) str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+Interner* interner_new(Arena* arena)
+{
+    Interner* in = (Interner*) malloc(sizeof(Interner));
+    in->slots = (uint32_t*) calloc(INTERNER_INITIAL_SLOTS, sizeof(uint32_t));
+    in->slotMask = INTERNER_INITIAL_SLOTS - 1;
+    in->entries = (InternerEntry*) malloc(INTERNER_INITIAL_ENTRIES * sizeof(InternerEntry));
+    in->size = 0;
+    in->capacity = INTERNER_INITIAL_ENTRIES;
+    in->arena = arena;
+    return in;
+}
+
+void interner_destroy(Interner* self)
+{
+    free(self->entries);
+    free(self->slots);
+    free(self);
+}
+
+void _in_grow(Interner* self)
+{
+    uint32_t newMask = self->slotMask * 2 + 1;
+    uint32_t* newSlots = (uint32_t*) calloc((size_t) newMask + 1, sizeof(uint32_t));
+    for (uint32_t id = 0; id < self->size; ++id)
+    {
+        uint32_t i = self->entries[id].hash & newMask;
+        while (newSlots[i] != 0)
+            i = (i + 1) & newMask;
+        newSlots[i] = id + 1;
+    }
+    free(self->slots);
+    self->slots = newSlots;
+    self->slotMask = newMask;
+}
+
+uint32_t interner_intern(Interner* self, const char* str, unsigned length)
+{
+    uint32_t hash = _in_hash(str, length);
+    uint32_t i = hash & self->slotMask;
+    uint32_t slot;
+
+    while ((slot = self->slots[i]) != 0)
+    {
+        const InternerEntry* entry = &self->entries[slot - 1];
+        if (entry->hash == hash && entry->length == length && memcmp(entry->str, str, length) == 0)
+            return slot - 1;
+        i = (i + 1) & self->slotMask;
+    }
+
+    // New string
+    if (self->size == self->capacity)
+    {
+        self->capacity *= 2;
+        self->entries = (InternerEntry*) realloc(self->entries, self->capacity * sizeof(InternerEntry));
+    }
+    uint32_t id = self->size++;
+    InternerEntry* entry = &self->entries[id];
+    entry->str = arena_allocString(self->arena, str, length, ArenaTag_INTERNER);
+    entry->length = length;
+    entry->hash = hash;
+    self->slots[i] = id + 1;
+
+    // Keep load factor under 1/2
+    if (self->size * 2 > self->slotMask)
+        _in_grow(self);
+
+    return id;
+}
+
+const char* interner_getString(const Interner* self, uint32_t id)
+{
+    assert(id < self->size);
+    return self->entries[id].str;
+}
+
+unsigned interner_getLength(const Interner* self, uint32_t id)
+{
+    assert(id < self->size);
+    return self->entries[id].length;
+}
+
+uint32_t interner_size(const Interner* self)
+{
+    return self->size;
+}
@@ -0,0 +1,665 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* September 2023
+*/
+
+/*
+* Build time generator of the lexer transition table.
+* Reads DFA/lexical_DFA.dot, groups the 256 byte values into equivalence
+* classes (bytes that behave the same in every state) and writes a C header
+* with the dense state x class transition table, the accepting states and
+* the error actions of each state.
+*
+* Usage: dfa_gen input.dot output.h
+*/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DG_MAX_STATES 126 // 0x7E and 0x7F are reserved as END and ERROR markers
+#define DG_CHARS 256
+#define DG_EOF_COLUMN DG_CHARS
+#define DG_MAX_TOKEN_LENGTH 256
+
+#define DG_LOOKAHEAD 0x80
+#define DG_END 0x7E
+#define DG_ERROR 0x7F
+
+typedef struct DgToken
+{
+    int isString;
+    char text[DG_MAX_TOKEN_LENGTH];
+} DgToken;
+
+typedef struct DgState
+{
+    int used;
+    int isFinal;
+    // Transition for every byte, plus one for EOF
+    unsigned char next[DG_CHARS + 1];
+    int hasOther;
+    int otherIsLookahead;
+    unsigned char otherTarget;
+    int otherExcludesNewline;
+    char onError[DG_MAX_TOKEN_LENGTH];
+    char onEof[DG_MAX_TOKEN_LENGTH];
+} DgState;
+
+typedef struct DgParser
+{
+    const char* filepath;
+    const char* cur;
+    unsigned line;
+    DgToken tok;
+    int hasTok;
+} DgParser;
+
+DgState states[DG_MAX_STATES];
+
+void _dg_fail(const DgParser* p, const char* msg, const char* arg)
+{
+    fprintf(stderr, "%s:%u: error: %s \"%s\".\n", p->filepath, p->line, msg, arg);
+    exit(-1);
+}
+
+void _dg_skipBlanksAndComments(DgParser* p)
+{
+    for (;;)
+    {
+        if (*p->cur == '\n')
+        {
+            ++p->line;
+            ++p->cur;
+        }
+        else if (isspace((unsigned char) *p->cur))
+        {
+            ++p->cur;
+        }
+        else if (p->cur[0] == '/' && p->cur[1] == '/')
+        {
+            while (*p->cur && *p->cur != '\n')
+                ++p->cur;
+        }
+        else if (p->cur[0] == '/' && p->cur[1] == '*')
+        {
+            p->cur += 2;
+            while (*p->cur && !(p->cur[0] == '*' && p->cur[1] == '/'))
+            {
+                if (*p->cur == '\n')
+                    ++p->line;
+                ++p->cur;
+            }
+            if (*p->cur)
+                p->cur += 2;
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+// Reads the next token: identifier/number, quoted string (unescaped) or punctuation
+int _dg_readToken(DgParser* p, DgToken* tok)
+{
+    _dg_skipBlanksAndComments(p);
+    unsigned length = 0;
+    tok->isString = 0;
+
+    if (*p->cur == '\0')
+    {
+        return 0;
+    }
+    else if (*p->cur == '"')
+    {
+        tok->isString = 1;
+        ++p->cur;
+        while (*p->cur && *p->cur != '"')
+        {
+            if (p->cur[0] == '\\' && (p->cur[1] == '"' || p->cur[1] == '\\'))
+                ++p->cur;
+            if (length + 1 == DG_MAX_TOKEN_LENGTH)
+                _dg_fail(p, "string too long", "");
+            tok->text[length++] = *p->cur++;
+        }
+        if (*p->cur != '"')
+            _dg_fail(p, "unterminated string", "");
+        ++p->cur;
+    }
+    else if (isalnum((unsigned char) *p->cur) || *p->cur == '_' || *p->cur == '.')
+    {
+        while (isalnum((unsigned char) *p->cur) || *p->cur == '_' || *p->cur == '.')
+        {
+            if (length + 1 == DG_MAX_TOKEN_LENGTH)
+                _dg_fail(p, "identifier too long", "");
+            tok->text[length++] = *p->cur++;
+        }
+    }
+    else if (p->cur[0] == '-' && p->cur[1] == '>')
+    {
+        tok->text[length++] = *p->cur++;
+        tok->text[length++] = *p->cur++;
+    }
+    else
+    {
+        tok->text[length++] = *p->cur++;
+    }
+    tok->text[length] = '\0';
+    return 1;
+}
+
+const DgToken* _dg_peek(DgParser* p)
+{
+    if (!p->hasTok)
+        p->hasTok = _dg_readToken(p, &p->tok) ? 1 : -1;
+    return p->hasTok == 1 ? &p->tok : NULL;
+}
+
+DgToken _dg_next(DgParser* p)
+{
+    if (!_dg_peek(p))
+        _dg_fail(p, "unexpected end of file", "");
+    p->hasTok = 0;
+    return p->tok;
+}
+
+int _dg_peekIs(DgParser* p, const char* text)
+{
+    const DgToken* tok = _dg_peek(p);
+    return tok && !tok->isString && strcmp(tok->text, text) == 0;
+}
+
+void _dg_expect(DgParser* p, const char* text)
+{
+    DgToken tok = _dg_next(p);
+    if (tok.isString || strcmp(tok.text, text) != 0)
+        _dg_fail(p, "expected", text);
+}
+
+unsigned _dg_stateId(DgParser* p, const char* text)
+{
+    char* endptr;
+    long id = strtol(text, &endptr, 10);
+    if (*endptr != '\0' || id < 0 || id >= DG_MAX_STATES)
+        _dg_fail(p, "invalid state name", text);
+    states[id].used = 1;
+    return (unsigned) id;
+}
+
+// Parses the optional ":port" after a node name
+void _dg_skipPort(DgParser* p)
+{
+    if (_dg_peekIs(p, ":"))
+    {
+        _dg_next(p);
+        _dg_next(p);
+    }
+}
+
+void _dg_setTransition(DgParser* p, DgState* st, unsigned c, unsigned char entry)
+{
+    if (st->next[c] != DG_ERROR)
+    {
+        char charStr[8];
+        snprintf(charStr, sizeof(charStr), "%u", c);
+        _dg_fail(p, "more than one transition for char", charStr);
+    }
+    st->next[c] = entry;
+}
+
+// Applies one label item (e.g. "letter", "[1,9]", "\n", "other#") to a transition
+void _dg_addLabelItem(DgParser* p, DgState* st, unsigned target, char* item)
+{
+    size_t length = strlen(item);
+    int lookahead = 0;
+    if (length > 1 && item[length - 1] == '#')
+    {
+        lookahead = 1;
+        item[--length] = '\0';
+    }
+    unsigned char entry = (unsigned char) (target | (lookahead ? DG_LOOKAHEAD : 0));
+
+    unsigned first;
+    unsigned last;
+    if (strcmp(item, "other") == 0 || strcmp(item, "char") == 0)
+    {
+        if (st->hasOther)
+            _dg_fail(p, "more than one default transition in label", item);
+        st->hasOther = 1;
+        st->otherIsLookahead = lookahead;
+        st->otherTarget = (unsigned char) target;
+        st->otherExcludesNewline = strcmp(item, "char") == 0;
+        return;
+    }
+    else if (strcmp(item, "letter") == 0)
+    {
+        for (unsigned c = 'a'; c <= 'z'; ++c)
+            _dg_setTransition(p, st, c, entry);
+        for (unsigned c = 'A'; c <= 'Z'; ++c)
+            _dg_setTransition(p, st, c, entry);
+        return;
+    }
+    else if (strcmp(item, "digit") == 0)
+    {
+        first = '0';
+        last = '9';
+    }
+    else if (strcmp(item, "space") == 0)
+    {
+        first = last = ' ';
+    }
+    else if (length == 2 && item[0] == '\\')
+    {
+        switch (item[1])
+        {
+        case 'n':
+            first = last = '\n';
+            break;
+        case 't':
+            first = last = '\t';
+            break;
+        case 'r':
+            first = last = '\r';
+            break;
+        default:
+            _dg_fail(p, "unknown escape in label", item);
+            return;
+        }
+    }
+    else if (length == 5 && item[0] == '[' && item[2] == ',' && item[4] == ']')
+    {
+        first = (unsigned char) item[1];
+        last = (unsigned char) item[3];
+    }
+    else if (length == 3 && item[0] == '"' && item[2] == '"')
+    {
+        first = last = (unsigned char) item[1];
+    }
+    else if (length == 1)
+    {
+        first = last = (unsigned char) item[0];
+    }
+    else
+    {
+        _dg_fail(p, "unknown label item", item);
+        return;
+    }
+
+    for (unsigned c = first; c <= last; ++c)
+        _dg_setTransition(p, st, c, entry);
+}
+
+// Splits a label on top level commas, keeping "[a,b]" and "\",\"" together
+void _dg_addLabel(DgParser* p, unsigned from, unsigned target, const char* label)
+{
+    const char* cur = label;
+    while (*cur)
+    {
+        char item[DG_MAX_TOKEN_LENGTH];
+        unsigned length = 0;
+        while (*cur == ' ')
+            ++cur;
+
+        if (cur[0] == '"' && cur[1] && cur[2] == '"')
+        {
+            memcpy(item, cur, 3);
+            length = 3;
+            cur += 3;
+        }
+        else if (cur[0] == '[')
+        {
+            while (*cur && *cur != ']')
+                item[length++] = *cur++;
+            if (*cur)
+                item[length++] = *cur++;
+        }
+        while (*cur && *cur != ',')
+            item[length++] = *cur++;
+        while (length > 0 && item[length - 1] == ' ')
+            --length;
+        item[length] = '\0';
+        if (*cur == ',')
+            ++cur;
+
+        if (length == 0)
+            _dg_fail(p, "empty item in label", label);
+        _dg_addLabelItem(p, &states[from], target, item);
+    }
+}
+
+// Parses "[name = value, ...]". Only label, on_error and on_eof are used.
+void _dg_parseAttributes(DgParser* p, char* label, char* onError, char* onEof, char* shape)
+{
+    _dg_expect(p, "[");
+    while (!_dg_peekIs(p, "]"))
+    {
+        DgToken name = _dg_next(p);
+        _dg_expect(p, "=");
+        DgToken value = _dg_next(p);
+        if (strcmp(name.text, "label") == 0 && label)
+            strcpy(label, value.text);
+        else if (strcmp(name.text, "on_error") == 0 && onError)
+            strcpy(onError, value.text);
+        else if (strcmp(name.text, "on_eof") == 0 && onEof)
+            strcpy(onEof, value.text);
+        else if (strcmp(name.text, "shape") == 0 && shape)
+            strcpy(shape, value.text);
+
+        if (_dg_peekIs(p, ",") || _dg_peekIs(p, ";"))
+            _dg_next(p);
+    }
+    _dg_expect(p, "]");
+}
+
+void _dg_parse(DgParser* p)
+{
+    char nodeShape[DG_MAX_TOKEN_LENGTH] = "circle";
+
+    _dg_expect(p, "digraph");
+    _dg_next(p); // graph name
+    _dg_expect(p, "{");
+
+    while (!_dg_peekIs(p, "}"))
+    {
+        DgToken tok = _dg_next(p);
+        if (!tok.isString && (strcmp(tok.text, ";") == 0 || strcmp(tok.text, ",") == 0))
+        {
+            continue;
+        }
+        else if (_dg_peekIs(p, "="))
+        {
+            // graph attribute, e.g. rankdir=LR
+            _dg_next(p);
+            _dg_next(p);
+        }
+        else if (strcmp(tok.text, "node") == 0 && _dg_peekIs(p, "["))
+        {
+            _dg_parseAttributes(p, NULL, NULL, NULL, nodeShape);
+        }
+        else if ((strcmp(tok.text, "edge") == 0 || strcmp(tok.text, "graph") == 0) && _dg_peekIs(p, "["))
+        {
+            _dg_parseAttributes(p, NULL, NULL, NULL, NULL);
+        }
+        else
+        {
+            unsigned from = _dg_stateId(p, tok.text);
+            _dg_skipPort(p);
+            if (_dg_peekIs(p, "->"))
+            {
+                _dg_next(p);
+                DgToken targetTok = _dg_next(p);
+                unsigned target = _dg_stateId(p, targetTok.text);
+                _dg_skipPort(p);
+                char label[DG_MAX_TOKEN_LENGTH] = "";
+                if (_dg_peekIs(p, "["))
+                    _dg_parseAttributes(p, label, NULL, NULL, NULL);
+                _dg_addLabel(p, from, target, label);
+            }
+            else
+            {
+                if (strcmp(nodeShape, "doublecircle") == 0)
+                    states[from].isFinal = 1;
+                if (_dg_peekIs(p, "["))
+                    _dg_parseAttributes(p, NULL, states[from].onError, states[from].onEof, NULL);
+            }
+        }
+    }
+    _dg_expect(p, "}");
+}
+
+// Fills default ("other"/"char") transitions and the EOF column
+void _dg_finishStates(DgParser* p)
+{
+    for (unsigned s = 0; s < DG_MAX_STATES; ++s)
+    {
+        DgState* st = &states[s];
+        if (!st->used || st->isFinal)
+            continue;
+
+        if (st->hasOther)
+        {
+            unsigned char entry = (unsigned char) (st->otherTarget | (st->otherIsLookahead ? DG_LOOKAHEAD : 0));
+            for (unsigned c = 0; c < DG_CHARS; ++c)
+            {
+                if (st->next[c] == DG_ERROR && !(st->otherExcludesNewline && c == '\n'))
+                    st->next[c] = entry;
+            }
+        }
+
+        if (strcmp(st->onEof, "end") == 0)
+        {
+            st->next[DG_EOF_COLUMN] = DG_END;
+        }
+        else if (st->onEof[0] == '\0')
+        {
+            // EOF behaves as any other char on lookahead transitions
+            if (!st->hasOther || !st->otherIsLookahead)
+            {
+                char stateStr[8];
+                snprintf(stateStr, sizeof(stateStr), "%u", s);
+                _dg_fail(p, "missing on_eof for state", stateStr);
+            }
+            st->next[DG_EOF_COLUMN] = (unsigned char) (st->otherTarget | DG_LOOKAHEAD);
+        }
+    }
+}
+
+void _dg_writeAction(FILE* out, const char* action)
+{
+    const char* colon = strchr(action, ':');
+    size_t nameLength = colon ? (size_t) (colon - action) : strlen(action);
+
+    if (nameLength == 0)
+        fprintf(out, "LaDfaAction_NONE, ");
+    else if (strncmp(action, "invalid_char", nameLength) == 0)
+        fprintf(out, "LaDfaAction_INVALID_CHAR, ");
+    else if (strncmp(action, "expected_char", nameLength) == 0)
+        fprintf(out, "LaDfaAction_EXPECTED_CHAR, ");
+    else if (strncmp(action, "expected_sequence", nameLength) == 0)
+        fprintf(out, "LaDfaAction_EXPECTED_SEQUENCE, ");
+    else if (strncmp(action, "missing", nameLength) == 0)
+        fprintf(out, "LaDfaAction_MISSING_SEQUENCE, ");
+    else if (strncmp(action, "end", nameLength) == 0)
+        fprintf(out, "LaDfaAction_NONE, ");
+    else
+    {
+        fprintf(stderr, "error: unknown action \"%s\".\n", action);
+        exit(-1);
+    }
+
+    if (colon)
+    {
+        fputc('"', out);
+        for (const char* c = colon + 1; *c; ++c)
+        {
+            if (*c == '"' || *c == '\\')
+                fputc('\\', out);
+            fputc(*c, out);
+        }
+        fputc('"', out);
+    }
+    else
+    {
+        fprintf(out, "NULL");
+    }
+}
+
+// Maps a transition entry from dot state names to dense row indexes
+unsigned char _dg_denseEntry(unsigned char entry, const unsigned char* denseIndex)
+{
+    if (entry == DG_END || entry == DG_ERROR)
+        return entry;
+    return (unsigned char) (denseIndex[entry & 0x7F] | (entry & DG_LOOKAHEAD));
+}
+
+void _dg_write(FILE* out, const char* inputPath)
+{
+    // Rows are only emitted for states present in the dot file
+    unsigned char denseIndex[DG_MAX_STATES];
+    unsigned stateName[DG_MAX_STATES];
+    unsigned stateCount = 0;
+    for (unsigned s = 0; s < DG_MAX_STATES; ++s)
+    {
+        if (states[s].used)
+        {
+            stateName[stateCount] = s;
+            denseIndex[s] = (unsigned char) stateCount++;
+        }
+    }
+
+    // Equivalence classes: bytes with the same column in every state
+    unsigned char charClass[DG_CHARS];
+    unsigned classRepresentative[DG_CHARS + 1];
+    unsigned classCount = 0;
+    for (unsigned c = 0; c < DG_CHARS; ++c)
+    {
+        unsigned k;
+        for (k = 0; k < classCount; ++k)
+        {
+            unsigned r = classRepresentative[k];
+            unsigned s;
+            for (s = 0; s < DG_MAX_STATES; ++s)
+                if (states[s].next[c] != states[s].next[r])
+                    break;
+            if (s == DG_MAX_STATES)
+                break;
+        }
+        if (k == classCount)
+            classRepresentative[classCount++] = c;
+        charClass[c] = (unsigned char) k;
+    }
+    unsigned eofClass = classCount;
+    classRepresentative[eofClass] = DG_EOF_COLUMN;
+
+    fprintf(out, "// Generated by tools/dfa_gen.c from %s. Do not edit.\n\n", inputPath);
+    fprintf(out, "#ifndef LEXICAL_DFA_TABLE_H\n#define LEXICAL_DFA_TABLE_H\n\n");
+    fprintf(out, "#include <stddef.h> // NULL\n\n");
+    fprintf(out, "// Row of each state of the dot file\n");
+    for (unsigned i = 0; i < stateCount; ++i)
+        fprintf(out, "#define LA_DFA_STATE_%u %u\n", stateName[i], i);
+    fprintf(out, "\n");
+    fprintf(out, "#define LA_DFA_STATE_COUNT %u\n", stateCount);
+    fprintf(out, "#define LA_DFA_CLASS_COUNT %u // including EOF\n", classCount + 1);
+    fprintf(out, "#define LA_DFA_EOF_CLASS %u\n", eofClass);
+    fprintf(out, "#define LA_DFA_LOOKAHEAD 0x%X // transition does not consume the char\n", DG_LOOKAHEAD);
+    fprintf(out, "#define LA_DFA_STATE_MASK 0x7F\n");
+    fprintf(out, "#define LA_DFA_END 0x%X // end of input, no more tokens\n", DG_END);
+    fprintf(out, "#define LA_DFA_ERROR 0x%X // no transition, see la_dfa_onError\n\n", DG_ERROR);
+
+    fprintf(out, "typedef enum LaDfaAction\n{\n"
+                 "    LaDfaAction_NONE,\n"
+                 "    LaDfaAction_INVALID_CHAR,\n"
+                 "    LaDfaAction_EXPECTED_CHAR,\n"
+                 "    LaDfaAction_EXPECTED_SEQUENCE,\n"
+                 "    LaDfaAction_MISSING_SEQUENCE\n"
+                 "} LaDfaAction;\n\n");
+    fprintf(out, "typedef struct LaDfaErrorAction\n{\n"
+                 "    LaDfaAction action;\n"
+                 "    const char* arg;\n"
+                 "} LaDfaErrorAction;\n\n");
+
+    fprintf(out, "static const unsigned char la_dfa_charClass[256] =\n{");
+    for (unsigned c = 0; c < DG_CHARS; ++c)
+        fprintf(out, "%s%2u,", c % 16 == 0 ? "\n    " : " ", charClass[c]);
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const unsigned char la_dfa_next[LA_DFA_STATE_COUNT][LA_DFA_CLASS_COUNT] =\n{\n");
+    for (unsigned i = 0; i < stateCount; ++i)
+    {
+        const DgState* st = &states[stateName[i]];
+        fprintf(out, "    {");
+        for (unsigned k = 0; k <= classCount; ++k)
+        {
+            unsigned char entry = st->isFinal ? DG_ERROR : _dg_denseEntry(st->next[classRepresentative[k]], denseIndex);
+            fprintf(out, "%s0x%02X", k ? ", " : "", entry);
+        }
+        fprintf(out, "}, // %u\n", stateName[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const unsigned char la_dfa_isFinal[LA_DFA_STATE_COUNT] =\n{\n   ");
+    for (unsigned i = 0; i < stateCount; ++i)
+        fprintf(out, " %d,", states[stateName[i]].isFinal);
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const LaDfaErrorAction la_dfa_onError[LA_DFA_STATE_COUNT] =\n{\n");
+    for (unsigned i = 0; i < stateCount; ++i)
+    {
+        fprintf(out, "    {");
+        _dg_writeAction(out, states[stateName[i]].onError);
+        fprintf(out, "}, // %u\n", stateName[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const LaDfaErrorAction la_dfa_onEof[LA_DFA_STATE_COUNT] =\n{\n");
+    for (unsigned i = 0; i < stateCount; ++i)
+    {
+        fprintf(out, "    {");
+        _dg_writeAction(out, states[stateName[i]].onEof);
+        fprintf(out, "}, // %u\n", stateName[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "#endif // LEXICAL_DFA_TABLE_H\n");
+}
+
+char* _dg_readFile(const char* filepath)
+{
+    FILE* file = fopen(filepath, "r");
+    if (!file)
+    {
+        fprintf(stderr, "Error: cannot open file \"%s\" in read mode. Exiting.\n", filepath);
+        exit(-1);
+    }
+    size_t capacity = 4096;
+    size_t length = 0;
+    char* buffer = (char*) malloc(capacity);
+    size_t nread;
+    while ((nread = fread(buffer + length, 1, capacity - length - 1, file)) > 0)
+    {
+        length += nread;
+        if (length + 1 == capacity)
+        {
+            capacity *= 2;
+            buffer = (char*) realloc(buffer, capacity);
+        }
+    }
+    buffer[length] = '\0';
+    fclose(file);
+    return buffer;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: \"%s input.dot output.h\".\n", argv[0]);
+        exit(-1);
+    }
+
+    for (unsigned s = 0; s < DG_MAX_STATES; ++s)
+        memset(states[s].next, DG_ERROR, sizeof(states[s].next));
+
+    char* source = _dg_readFile(argv[1]);
+    DgParser parser = {argv[1], source, 1, {0, ""}, 0};
+    _dg_parse(&parser);
+    _dg_finishStates(&parser);
+
+    FILE* out = fopen(argv[2], "w");
+    if (!out)
+    {
+        fprintf(stderr, "Error: cannot open file \"%s\" in write mode. Exiting.\n", argv[2]);
+        exit(-1);
+    }
+    _dg_write(out, argv[1]);
+    fclose(out);
+    free(source);
+    return 0;
+}
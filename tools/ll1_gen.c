@@ -0,0 +1,670 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Build time generator of the parser tables.
+* Reads grammar/syntactic.ll1, computes the First and Follow sets of its
+* rules and writes a C header with the symbols of each alternative and the
+* alternative of each rule to expand on each lookahead token. A grammar
+* that is not LL(1) (two alternatives predicted on the same token) fails
+* the build. Actions (@name) are run by the parser as it pops them off its
+* stack, before the terminal that follows them is eaten.
+*
+* Rules of a single alternative are replaced by it where they are used, and
+* the alternative predicted for a rule on a token is flattened: rules at its
+* start are replaced by their alternative predicted on the same token, up to
+* its first terminal. The parser then expands once per terminal instead of
+* once per rule, e.g. a statement list, statement and assignment on an ID at
+* once. So actions before the first terminal of an alternative must not eat
+* tokens, as the rules after them are already expanded on the current one.
+*
+* Usage: ll1_gen input.ll1 output.h
+*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LG_MAX_NAME_LENGTH 64
+#define LG_MAX_TERMINALS 64 // bits of an LgSet
+#define LG_MAX_RULES 128
+#define LG_MAX_ACTIONS 128
+#define LG_MAX_PRODUCTIONS 255 // numbered from 1 in an unsigned char
+#define LG_MAX_PRODUCTION_LENGTH 48 // inlined and flattened ones included
+#define LG_RULE_BIT 0x100u // symbols below it are terminals
+#define LG_ACTION_BIT 0x200u
+
+#define LG_LAMBDA "lambda"
+#define LG_END_OF_FILE "END_OF_FILE" // follows the start rule
+
+typedef uint64_t LgSet; // of terminals, by index
+
+typedef struct LgRule
+{
+    char name[LG_MAX_NAME_LENGTH];
+    unsigned line; // of its definition, 0 if only referenced
+    unsigned firstProduction; // its alternatives follow it
+    int nullable;
+    LgSet first;
+    LgSet follow;
+} LgRule;
+
+typedef struct LgProduction
+{
+    unsigned rule;
+    unsigned line; // 0 if flattened
+    unsigned length;
+    unsigned symbols[LG_MAX_PRODUCTION_LENGTH];
+} LgProduction;
+
+typedef struct LgParser
+{
+    const char* filepath;
+    const char* cur;
+    unsigned line;
+    char tok[LG_MAX_NAME_LENGTH];
+} LgParser;
+
+char terminals[LG_MAX_TERMINALS][LG_MAX_NAME_LENGTH];
+unsigned terminalCount;
+LgRule rules[LG_MAX_RULES];
+unsigned ruleCount;
+char actions[LG_MAX_ACTIONS][LG_MAX_NAME_LENGTH];
+unsigned actionCount;
+LgProduction productions[LG_MAX_PRODUCTIONS];
+unsigned productionCount;
+unsigned grammarProductionCount; // the alternatives of the grammar, before the flattened ones
+
+void _lg_fail(const char* filepath, unsigned line, const char* msg, const char* arg)
+{
+    fprintf(stderr, "%s:%u: error: %s \"%s\".\n", filepath, line, msg, arg);
+    exit(-1);
+}
+
+// Reads the next token: a name, an @action, ':', '|' or ';'. Empty at the end of the input
+void _lg_next(LgParser* p)
+{
+    for (;;)
+    {
+        if (*p->cur == '\n')
+        {
+            ++p->line;
+            ++p->cur;
+        }
+        else if (isspace((unsigned char) *p->cur))
+        {
+            ++p->cur;
+        }
+        else if (*p->cur == '#')
+        {
+            while (*p->cur && *p->cur != '\n')
+                ++p->cur;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    unsigned length = 0;
+    if (*p->cur == '@')
+        p->tok[length++] = *p->cur++;
+    if (isalpha((unsigned char) *p->cur) || *p->cur == '_')
+    {
+        while (isalnum((unsigned char) *p->cur) || *p->cur == '_' || *p->cur == '-')
+        {
+            if (length + 1 == LG_MAX_NAME_LENGTH)
+                _lg_fail(p->filepath, p->line, "name too long", "");
+            p->tok[length++] = *p->cur++;
+        }
+    }
+    else if (length > 0)
+    {
+        _lg_fail(p->filepath, p->line, "expected an action name after", "@");
+    }
+    else if (*p->cur == ':' || *p->cur == '|' || *p->cur == ';')
+    {
+        p->tok[length++] = *p->cur++;
+    }
+    else if (*p->cur)
+    {
+        char charStr[2] = {*p->cur, '\0'};
+        _lg_fail(p->filepath, p->line, "unexpected char", charStr);
+    }
+    p->tok[length] = '\0';
+}
+
+void _lg_expect(LgParser* p, const char* text)
+{
+    if (strcmp(p->tok, text) != 0)
+        _lg_fail(p->filepath, p->line, "expected", text);
+    _lg_next(p);
+}
+
+int _lg_isRuleName(const char* name)
+{
+    return islower((unsigned char) name[0]);
+}
+
+unsigned _lg_terminal(LgParser* p, const char* name)
+{
+    for (unsigned t = 0; t < terminalCount; ++t)
+        if (strcmp(terminals[t], name) == 0)
+            return t;
+    if (terminalCount == LG_MAX_TERMINALS)
+        _lg_fail(p->filepath, p->line, "too many terminals at", name);
+    strcpy(terminals[terminalCount], name);
+    return terminalCount++;
+}
+
+unsigned _lg_action(LgParser* p, const char* name)
+{
+    for (unsigned a = 0; a < actionCount; ++a)
+        if (strcmp(actions[a], name) == 0)
+            return a;
+    if (actionCount == LG_MAX_ACTIONS)
+        _lg_fail(p->filepath, p->line, "too many actions at", name);
+    strcpy(actions[actionCount], name);
+    return actionCount++;
+}
+
+unsigned _lg_rule(LgParser* p, const char* name)
+{
+    for (unsigned r = 0; r < ruleCount; ++r)
+        if (strcmp(rules[r].name, name) == 0)
+            return r;
+    if (ruleCount == LG_MAX_RULES)
+        _lg_fail(p->filepath, p->line, "too many rules at", name);
+    strcpy(rules[ruleCount].name, name);
+    return ruleCount++;
+}
+
+// alternative : symbol symbol ... | "lambda"
+void _lg_parseAlternative(LgParser* p, unsigned rule)
+{
+    if (productionCount == LG_MAX_PRODUCTIONS)
+        _lg_fail(p->filepath, p->line, "too many alternatives in rule", rules[rule].name);
+    LgProduction* production = &productions[productionCount++];
+    production->rule = rule;
+    production->line = p->line;
+    production->length = 0;
+
+    if (strcmp(p->tok, LG_LAMBDA) == 0)
+    {
+        _lg_next(p);
+        return;
+    }
+    while (p->tok[0] && strcmp(p->tok, "|") != 0 && strcmp(p->tok, ";") != 0)
+    {
+        if (strcmp(p->tok, ":") == 0 || strcmp(p->tok, LG_LAMBDA) == 0)
+            _lg_fail(p->filepath, p->line, "unexpected", p->tok);
+        if (production->length == LG_MAX_PRODUCTION_LENGTH)
+            _lg_fail(p->filepath, p->line, "alternative too long in rule", rules[rule].name);
+        unsigned symbol;
+        if (p->tok[0] == '@')
+            symbol = LG_ACTION_BIT | _lg_action(p, p->tok + 1);
+        else if (_lg_isRuleName(p->tok))
+            symbol = LG_RULE_BIT | _lg_rule(p, p->tok);
+        else
+            symbol = _lg_terminal(p, p->tok);
+        production->symbols[production->length++] = symbol;
+        _lg_next(p);
+    }
+    if (production->length == 0)
+        _lg_fail(p->filepath, p->line, "empty alternative (write \"lambda\") in rule", rules[rule].name);
+}
+
+void _lg_parse(LgParser* p)
+{
+    _lg_terminal(p, LG_END_OF_FILE);
+    _lg_next(p);
+    while (p->tok[0])
+    {
+        if (!_lg_isRuleName(p->tok))
+            _lg_fail(p->filepath, p->line, "expected a rule name, got", p->tok);
+        unsigned rule = _lg_rule(p, p->tok);
+        if (rules[rule].line)
+            _lg_fail(p->filepath, p->line, "redefinition of rule", p->tok);
+        rules[rule].line = p->line;
+        rules[rule].firstProduction = productionCount;
+        _lg_next(p);
+        _lg_expect(p, ":");
+
+        _lg_parseAlternative(p, rule);
+        while (strcmp(p->tok, "|") == 0)
+        {
+            _lg_next(p);
+            _lg_parseAlternative(p, rule);
+        }
+        _lg_expect(p, ";");
+    }
+
+    if (ruleCount == 0)
+        _lg_fail(p->filepath, p->line, "no rules in", p->filepath);
+    for (unsigned r = 0; r < ruleCount; ++r)
+        if (!rules[r].line)
+            _lg_fail(p->filepath, p->line, "undefined rule", rules[r].name);
+}
+
+// Whether rule has a single alternative, which the parser would expand on any token
+int _lg_isSingle(unsigned rule)
+{
+    unsigned first = rules[rule].firstProduction;
+    return first + 1 == productionCount || productions[first + 1].rule != rule;
+}
+
+// Replaces the rules of a single alternative by its symbols in the alternatives using
+// them, unless that makes them too long. Rules are left as they are, only unused
+void _lg_inline(void)
+{
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        LgProduction* production = &productions[i];
+        unsigned k = 0;
+        unsigned inlined = 0; // bounds cycles of rules that derive no terminal, e.g. "a : b ; b : a ;"
+        while (k < production->length && inlined < LG_MAX_RULES)
+        {
+            unsigned symbol = production->symbols[k];
+            unsigned rule = symbol & ~LG_RULE_BIT;
+            if (!(symbol & LG_RULE_BIT) || rule == production->rule || !_lg_isSingle(rule))
+            {
+                ++k;
+                continue;
+            }
+            const LgProduction* inner = &productions[rules[rule].firstProduction];
+            if (production->length - 1 + inner->length > LG_MAX_PRODUCTION_LENGTH)
+            {
+                ++k;
+                continue;
+            }
+            // Its own rules are inlined next, from k
+            memmove(&production->symbols[k + inner->length], &production->symbols[k + 1], (production->length - k - 1) * sizeof(unsigned));
+            memcpy(&production->symbols[k], inner->symbols, inner->length * sizeof(unsigned));
+            production->length += inner->length - 1;
+            ++inlined;
+        }
+    }
+}
+
+// First of symbols[from..length), and whether they all derive lambda
+LgSet _lg_firstOfSequence(const LgProduction* production, unsigned from, int* nullable)
+{
+    LgSet first = 0;
+    for (unsigned i = from; i < production->length; ++i)
+    {
+        unsigned symbol = production->symbols[i];
+        if (symbol & LG_ACTION_BIT)
+            continue;
+        if (!(symbol & LG_RULE_BIT))
+        {
+            *nullable = 0;
+            return first | (LgSet) 1 << symbol;
+        }
+        const LgRule* rule = &rules[symbol & ~LG_RULE_BIT];
+        first |= rule->first;
+        if (!rule->nullable)
+        {
+            *nullable = 0;
+            return first;
+        }
+    }
+    *nullable = 1;
+    return first;
+}
+
+// Fixed points of First/nullable, then of Follow
+void _lg_computeSets(void)
+{
+    int changed = 1;
+    while (changed)
+    {
+        changed = 0;
+        for (unsigned i = 0; i < productionCount; ++i)
+        {
+            LgRule* rule = &rules[productions[i].rule];
+            int nullable;
+            LgSet first = rule->first | _lg_firstOfSequence(&productions[i], 0, &nullable);
+            if (first != rule->first || (nullable && !rule->nullable))
+            {
+                rule->first = first;
+                rule->nullable |= nullable;
+                changed = 1;
+            }
+        }
+    }
+
+    rules[0].follow = (LgSet) 1 << 0; // END_OF_FILE is terminal 0
+    changed = 1;
+    while (changed)
+    {
+        changed = 0;
+        for (unsigned i = 0; i < productionCount; ++i)
+        {
+            const LgProduction* production = &productions[i];
+            for (unsigned k = 0; k < production->length; ++k)
+            {
+                unsigned symbol = production->symbols[k];
+                if (!(symbol & LG_RULE_BIT))
+                    continue;
+                LgRule* rule = &rules[symbol & ~LG_RULE_BIT];
+                int nullable;
+                LgSet follow = rule->follow | _lg_firstOfSequence(production, k + 1, &nullable);
+                if (nullable)
+                    follow |= rules[production->rule].follow;
+                if (follow != rule->follow)
+                {
+                    rule->follow = follow;
+                    changed = 1;
+                }
+            }
+        }
+    }
+}
+
+// predict[rule][terminal]: alternative to expand, numbered from 1 over the whole grammar,
+// 0 if none
+void _lg_buildPredict(const char* filepath, unsigned char predict[LG_MAX_RULES][LG_MAX_TERMINALS])
+{
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        const LgProduction* production = &productions[i];
+        const LgRule* rule = &rules[production->rule];
+        int nullable;
+        LgSet lookahead = _lg_firstOfSequence(production, 0, &nullable);
+        if (nullable)
+            lookahead |= rule->follow;
+
+        for (unsigned t = 0; t < terminalCount; ++t)
+        {
+            if (!(lookahead & (LgSet) 1 << t))
+                continue;
+            if (predict[production->rule][t])
+            {
+                char conflict[2 * LG_MAX_NAME_LENGTH + 8];
+                snprintf(conflict, sizeof(conflict), "%s\" on \"%s", rule->name, terminals[t]);
+                _lg_fail(filepath, production->line, "LL(1) conflict between alternatives of rule", conflict);
+            }
+            predict[production->rule][t] = (unsigned char) (i + 1);
+        }
+    }
+}
+
+// Number of the flattened alternative with the symbols of flat, added if there is none
+unsigned _lg_addFlattened(const char* filepath, const LgProduction* flat)
+{
+    for (unsigned i = grammarProductionCount; i < productionCount; ++i)
+    {
+        const LgProduction* production = &productions[i];
+        if (production->rule == flat->rule && production->length == flat->length &&
+            memcmp(production->symbols, flat->symbols, flat->length * sizeof(unsigned)) == 0)
+            return i + 1;
+    }
+    if (productionCount == LG_MAX_PRODUCTIONS)
+        _lg_fail(filepath, rules[flat->rule].line, "too many flattened alternatives of rule", rules[flat->rule].name);
+    productions[productionCount] = *flat;
+    productions[productionCount].line = 0;
+    return ++productionCount;
+}
+
+// Replaces the alternative of each rule on each token by its flattening: while the first
+// symbol past the actions is a rule, it is replaced by its alternative predicted by the
+// same token, as the parser would expand it next. Stops at a terminal, or at a rule the
+// token predicts no alternative of, so its error shows as before
+void _lg_flatten(const char* filepath, unsigned char predict[LG_MAX_RULES][LG_MAX_TERMINALS])
+{
+    grammarProductionCount = productionCount;
+    for (unsigned r = 0; r < ruleCount; ++r)
+    {
+        for (unsigned t = 0; t < terminalCount; ++t)
+        {
+            if (!predict[r][t])
+                continue;
+            LgProduction flat = productions[predict[r][t] - 1];
+            unsigned expanded = 0;
+            for (; expanded < LG_MAX_RULES; ++expanded) // an LL(1) grammar has no left recursion
+            {
+                unsigned k = 0;
+                while (k < flat.length && (flat.symbols[k] & LG_ACTION_BIT))
+                    ++k;
+                if (k == flat.length || !(flat.symbols[k] & LG_RULE_BIT))
+                    break;
+                unsigned alternative = predict[flat.symbols[k] & ~LG_RULE_BIT][t];
+                if (!alternative)
+                    break;
+                const LgProduction* inner = &productions[alternative - 1];
+                if (flat.length - 1 + inner->length > LG_MAX_PRODUCTION_LENGTH)
+                    break;
+                memmove(&flat.symbols[k + inner->length], &flat.symbols[k + 1], (flat.length - k - 1) * sizeof(unsigned));
+                memcpy(&flat.symbols[k], inner->symbols, inner->length * sizeof(unsigned));
+                flat.length += inner->length - 1;
+            }
+            if (expanded)
+                predict[r][t] = (unsigned char) _lg_addFlattened(filepath, &flat);
+        }
+    }
+}
+
+// Alternative to expand on a token that predicts none: the lambda one, or the only one, so
+// the error shows at the next terminal. 0 if the rule has several others
+unsigned _lg_default(unsigned r)
+{
+    unsigned end = rules[r].firstProduction;
+    while (end < grammarProductionCount && productions[end].rule == r)
+        ++end;
+    for (unsigned i = rules[r].firstProduction; i < end; ++i)
+    {
+        int nullable;
+        _lg_firstOfSequence(&productions[i], 0, &nullable);
+        if (nullable)
+            return i + 1;
+    }
+    return end - rules[r].firstProduction == 1 ? end : 0;
+}
+
+// "ident-list-i" as "IDENT_LIST_I"
+void _lg_writeUpper(FILE* out, const char* name)
+{
+    for (const char* c = name; *c; ++c)
+        fputc(*c == '-' ? '_' : toupper((unsigned char) *c), out);
+}
+
+// As in the grammar, single alternatives inlined, e.g. "stmt : ID ASSIGN @assign simple-expr",
+// or "stmt => ..." if flattened
+void _lg_writeAlternative(FILE* out, const LgProduction* production)
+{
+    fprintf(out, "%s %s", rules[production->rule].name, production->line ? ":" : "=>");
+    if (production->length == 0)
+        fprintf(out, " %s", LG_LAMBDA);
+    for (unsigned k = 0; k < production->length; ++k)
+    {
+        unsigned symbol = production->symbols[k];
+        if (symbol & LG_ACTION_BIT)
+            fprintf(out, " @%s", actions[symbol & ~LG_ACTION_BIT]);
+        else if (symbol & LG_RULE_BIT)
+            fprintf(out, " %s", rules[symbol & ~LG_RULE_BIT].name);
+        else
+            fprintf(out, " %s", terminals[symbol]);
+    }
+}
+
+void _lg_writeSymbol(FILE* out, unsigned symbol)
+{
+    if (symbol & LG_ACTION_BIT)
+    {
+        fprintf(out, "SA_LL1_ACTION | SaAction_");
+        _lg_writeUpper(out, actions[symbol & ~LG_ACTION_BIT]);
+    }
+    else if (symbol & LG_RULE_BIT)
+    {
+        fprintf(out, "SA_LL1_RULE | SaRule_");
+        _lg_writeUpper(out, rules[symbol & ~LG_RULE_BIT].name);
+    }
+    else
+    {
+        fprintf(out, "TokenType_%s", terminals[symbol]);
+    }
+}
+
+void _lg_write(FILE* out, const char* inputPath, unsigned char predict[LG_MAX_RULES][LG_MAX_TERMINALS])
+{
+    fprintf(out, "// Generated by tools/ll1_gen.c from %s. Do not edit.\n\n", inputPath);
+    fprintf(out, "#ifndef SYNTACTIC_LL1_TABLE_H\n#define SYNTACTIC_LL1_TABLE_H\n\n");
+    fprintf(out, "#include \"lexical/token.h\"\n\n#include <stdint.h>\n\n");
+
+    // Rules are written in grammar order: those of the alternatives
+    fprintf(out, "typedef enum SaRule\n{\n");
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        if (i != rules[productions[i].rule].firstProduction)
+            continue;
+        fprintf(out, "    SaRule_");
+        _lg_writeUpper(out, rules[productions[i].rule].name);
+        fprintf(out, ",\n");
+    }
+    fprintf(out, "\n    // Not to be used, only to get how many rules are\n    SaRule_SIZE\n} SaRule;\n\n");
+
+    fprintf(out, "typedef enum SaAction\n{\n");
+    for (unsigned a = 0; a < actionCount; ++a)
+    {
+        fprintf(out, "    SaAction_");
+        _lg_writeUpper(out, actions[a]);
+        fprintf(out, ",\n");
+    }
+    fprintf(out, "\n    // Not to be used, only to get how many actions are\n    SaAction_SIZE\n} SaAction;\n\n");
+
+    fprintf(out, "// Symbols of the alternatives: TokenTypes, then rules and actions\n");
+    fprintf(out, "#define SA_LL1_RULE 0x%x // | SaRule\n", LG_RULE_BIT);
+    fprintf(out, "#define SA_LL1_ACTION 0x%x // | SaAction\n\n", LG_ACTION_BIT);
+
+    fprintf(out, "// Each alternative backwards, as it is pushed on the parser stack\n");
+    fprintf(out, "static const uint16_t sa_ll1_symbols[] =\n{\n");
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        const LgProduction* production = &productions[i];
+        fprintf(out, "    // ");
+        _lg_writeAlternative(out, production);
+        fprintf(out, "\n");
+        for (unsigned k = production->length; k-- > 0;)
+        {
+            fprintf(out, "    ");
+            _lg_writeSymbol(out, production->symbols[k]);
+            fprintf(out, ",\n");
+        }
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "typedef struct SaLl1Production\n{\n");
+    fprintf(out, "    uint16_t first; // in sa_ll1_symbols\n    uint16_t length;\n} SaLl1Production;\n\n");
+    fprintf(out, "// Alternatives, numbered from 1 in grammar order, then the flattened ones (=>)\n");
+    fprintf(out, "#define SA_LL1_NONE 0 // no alternative: syntax error\n");
+    fprintf(out, "static const SaLl1Production sa_ll1_productions[] =\n{\n    [SA_LL1_NONE] = {0, 0},\n");
+    unsigned first = 0;
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        fprintf(out, "    {%u, %u}, // %u: ", first, productions[i].length, i + 1);
+        _lg_writeAlternative(out, &productions[i]);
+        fprintf(out, "\n");
+        first += productions[i].length;
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Alternative of each rule to expand on each lookahead token, flattened up to its first\n"
+                 "// terminal. Lambda alternatives are predicted on the Follow of their rule\n");
+    fprintf(out, "static const unsigned char sa_ll1_predict[SaRule_SIZE][TokenType_SIZE] =\n{\n");
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        unsigned r = productions[i].rule;
+        if (i != rules[r].firstProduction)
+            continue;
+        fprintf(out, "    [SaRule_");
+        _lg_writeUpper(out, rules[r].name);
+        fprintf(out, "] =\n    {\n");
+        for (unsigned t = 0; t < terminalCount; ++t)
+        {
+            if (predict[r][t])
+                fprintf(out, "        [TokenType_%s] = %u,\n", terminals[t], predict[r][t]);
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Alternative to expand on the tokens that predict none: the lambda one, or the only\n"
+                 "// one, so the error shows at the next terminal. SA_LL1_NONE if there are several\n");
+    fprintf(out, "static const unsigned char sa_ll1_default[SaRule_SIZE] =\n{\n");
+    for (unsigned i = 0; i < productionCount; ++i)
+    {
+        unsigned r = productions[i].rule;
+        if (i != rules[r].firstProduction)
+            continue;
+        fprintf(out, "    [SaRule_");
+        _lg_writeUpper(out, rules[r].name);
+        fprintf(out, "] = %u,\n", _lg_default(r));
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "#endif // SYNTACTIC_LL1_TABLE_H\n");
+}
+
+char* _lg_readFile(const char* filepath)
+{
+    FILE* file = fopen(filepath, "r");
+    if (!file)
+    {
+        fprintf(stderr, "Error: cannot open file \"%s\" in read mode. Exiting.\n", filepath);
+        exit(-1);
+    }
+    size_t capacity = 4096;
+    size_t length = 0;
+    char* buffer = (char*) malloc(capacity);
+    size_t nread;
+    while ((nread = fread(buffer + length, 1, capacity - length - 1, file)) > 0)
+    {
+        length += nread;
+        if (length + 1 == capacity)
+        {
+            capacity *= 2;
+            buffer = (char*) realloc(buffer, capacity);
+        }
+    }
+    buffer[length] = '\0';
+    fclose(file);
+    return buffer;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: \"%s input.ll1 output.h\".\n", argv[0]);
+        exit(-1);
+    }
+
+    char* source = _lg_readFile(argv[1]);
+    LgParser parser = {argv[1], source, 1, ""};
+    _lg_parse(&parser);
+    _lg_inline();
+    _lg_computeSets();
+    static unsigned char predict[LG_MAX_RULES][LG_MAX_TERMINALS];
+    _lg_buildPredict(argv[1], predict);
+    _lg_flatten(argv[1], predict);
+
+    FILE* out = fopen(argv[2], "w");
+    if (!out)
+    {
+        fprintf(stderr, "Error: cannot open file \"%s\" in write mode. Exiting.\n", argv[2]);
+        exit(-1);
+    }
+    _lg_write(out, argv[1], predict);
+    fclose(out);
+    free(source);
+    return 0;
+}
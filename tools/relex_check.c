@@ -0,0 +1,187 @@
+/*
+* Caio Vinicius Pereira Silveira
+* Leonardo Gonçalves Grossi
+* Mariana Gurgel Ferreira
+*
+* Compiler for a simple programming language
+*
+* October 2023
+*/
+
+/*
+* Test of incremental relexing (lexical_analyzer_relex).
+* Applies an edit to a source file, relexes the tokens of the original source,
+* and checks them against tokenizing the edited source at once. Prints the
+* changed token range, or fails at the first difference.
+*
+* Usage: relex_check OFFSET:REMOVED:TEXT source_filepath
+* TEXT takes \n, \t, \s (space) and \\ escapes.
+*/
+
+#include "lexical/lexical_analyzer.h"
+#include "lexical/token_buffer.h"
+#include "util/arena.h"
+#include "util/interner.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h> // write, close, unlink
+
+// Whether token index of a and b is the same, payload included
+int _rc_sameToken(const TokenBuffer* a, const TokenBuffer* b, size_t index)
+{
+    Token ta = token_buffer_get(a, index);
+    Token tb = token_buffer_get(b, index);
+    if (ta.type != tb.type || ta.offset != tb.offset)
+        return 0;
+    switch (ta.type)
+    {
+    case TokenType_INTEGER:
+        return ta.longVal == tb.longVal;
+    case TokenType_REAL:
+        return memcmp(&ta.doubleVal, &tb.doubleVal, sizeof(double)) == 0;
+    case TokenType_ID:
+        return ta.symbolId == tb.symbolId;
+    case TokenType_LITERAL:
+        return ta.literalId == tb.literalId;
+    default:
+        return 1;
+    }
+}
+
+// Whether the errors of a and b are the same
+int _rc_sameErrors(const TokenBuffer* a, const TokenBuffer* b)
+{
+    if (a->errorCount != b->errorCount)
+        return 0;
+    for (size_t i = 0; i < a->errorCount; ++i)
+    {
+        if (a->errors[i].index != b->errors[i].index || a->errors[i].offset != b->errors[i].offset ||
+            strcmp(a->errors[i].message, b->errors[i].message) != 0)
+            return 0;
+    }
+    return 1;
+}
+
+// Reads the whole file into a malloc'd buffer. Returns NULL if it cannot be read
+char* _rc_readFile(const char* filepath, size_t* size)
+{
+    FILE* file = fopen(filepath, "rb");
+    if (file == NULL)
+        return NULL;
+    char* data = NULL;
+    long length;
+    if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0)
+    {
+        data = (char*) malloc((size_t) length + 1);
+        *size = fread(data, 1, (size_t) length, file);
+    }
+    fclose(file);
+    return data;
+}
+
+// Parses OFFSET:REMOVED:TEXT into edit, and the unescaped TEXT into inserted. Returns 0 if malformed
+int _rc_parseEdit(const char* spec, SourceEdit* edit, char* inserted)
+{
+    char* endptr;
+    edit->offset = strtoul(spec, &endptr, 10);
+    if (*endptr != ':')
+        return 0;
+    edit->removedLength = strtoul(endptr + 1, &endptr, 10);
+    if (*endptr != ':')
+        return 0;
+
+    const char* text = endptr + 1;
+    edit->insertedLength = 0;
+    for (; *text != '\0'; ++text)
+    {
+        char c = *text;
+        if (c == '\\' && text[1] != '\0')
+        {
+            c = *++text;
+            c = c == 'n' ? '\n' : c == 't' ? '\t' : c == 's' ? ' ' : c;
+        }
+        inserted[edit->insertedLength++] = c;
+    }
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: \"%s OFFSET:REMOVED:TEXT source_filepath\".\n", argv[0]);
+        return -1;
+    }
+    char* filepath = argv[2];
+
+    SourceEdit edit;
+    char* inserted = (char*) malloc(strlen(argv[1]) + 1);
+    size_t size = 0;
+    char* source = _rc_readFile(filepath, &size);
+    if (!_rc_parseEdit(argv[1], &edit, inserted) || source == NULL || edit.offset + edit.removedLength > size)
+    {
+        fprintf(stderr, "Invalid edit \"%s\" of \"%s\".\n", argv[1], filepath);
+        free(source);
+        free(inserted);
+        return -1;
+    }
+    size_t editedSize = size - edit.removedLength + edit.insertedLength;
+    char* edited = (char*) malloc(editedSize + 1);
+    memcpy(edited, source, edit.offset);
+    memcpy(edited + edit.offset, inserted, edit.insertedLength);
+    memcpy(edited + edit.offset + edit.insertedLength, source + edit.offset + edit.removedLength, size - edit.offset - edit.removedLength);
+
+    // The edited source is tokenized at once from a file, as the compiler would
+    char editedPath[] = "/tmp/relex_checkXXXXXX";
+    int fd = mkstemp(editedPath);
+    if (fd < 0 || write(fd, edited, editedSize) != (ssize_t) editedSize)
+    {
+        fprintf(stderr, "Could not write \"%s\".\n", editedPath);
+        return -1;
+    }
+    close(fd);
+
+    Arena* arena = arena_new();
+    Interner* interner = interner_new(arena);
+    TokenBuffer tokens;
+    TokenBuffer expected;
+    LexicalAnalyzer* la = lexical_analyzer_new(filepath, interner);
+    lexical_analyzer_tokenizeAll(la, &tokens);
+    lexical_analyzer_destroy(la);
+    la = lexical_analyzer_new(editedPath, interner);
+    lexical_analyzer_tokenizeAll(la, &expected);
+    lexical_analyzer_destroy(la);
+    unlink(editedPath);
+
+    TokenRange changed = lexical_analyzer_relex(&tokens, edited, editedSize, &edit, interner);
+    size_t index = 0;
+    while (index < tokens.size && index < expected.size && _rc_sameToken(&tokens, &expected, index))
+        ++index;
+
+    int status = 0;
+    if (index < tokens.size || index < expected.size)
+    {
+        fprintf(stderr, "Relexed tokens differ from the edited source ones at token %zu.\n", index);
+        status = -1;
+    }
+    else if (!_rc_sameErrors(&tokens, &expected))
+    {
+        fprintf(stderr, "Relexed errors differ from the edited source ones.\n");
+        status = -1;
+    }
+    else
+    {
+        printf("Relexed tokens %zu to %zu into %zu tokens, of %zu.\n", changed.first, changed.first + changed.oldCount, changed.newCount, tokens.size);
+    }
+
+    token_buffer_free(&expected);
+    token_buffer_free(&tokens);
+    interner_destroy(interner);
+    arena_destroy(arena);
+    free(edited);
+    free(source);
+    free(inserted);
+    return status;
+}